@@ -5,29 +5,113 @@
 // UnrealServiceLocator
 #include "ServiceLocatorAccessors.h"
 #include "ServiceLocatorContainer.h"
+#include "ServiceLocatorContainerRegistry.h"
+#include "ServiceLocatorDiagnostics.h"
 #include "ServiceLocatorInterface.h"
+#include "ServiceLocatorWorldRegistry.h"
 
 // Engine
 #include "Engine/Engine.h"
+#include "Engine/LocalPlayer.h"
 #include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "UObject/UObjectAnnotation.h"
 
 ///////////////////////////////////////////////////////////////////////////
 
 namespace ServiceLocatorAccessors_Private
 {
 
-	const IServiceLocatorInterface* GetGameStateService_GetGameStateSLIFromWorldContextObject(const UObject* WorldContextObject)
+	struct FPlayerContainerAnnotation
+	{
+		TWeakObjectPtr<UServiceLocatorContainer> Container;
+
+		// FServiceLocatorContainerRegistry::GetContainersGeneration() when the container was resolved
+		uint32 ContainersGeneration = 0;
+
+		FORCEINLINE bool IsDefault() const
+		{
+			return Container.IsExplicitlyNull();
+		}
+	};
+
+	// Per-player container cache, indexed by the player object's UObject index and cleared automatically when it's destroyed.
+	// Entries are only used while no container has been created, destroyed, attached or detached since they were resolved.
+	static FUObjectAnnotationDense<FPlayerContainerAnnotation, true> PlayerContainerAnnotations;
+
+	enum class EPlayerAccessor : uint8
+	{
+		PlayerState,
+		PlayerController,
+		LocalPlayer
+	};
+
+	// Templated on the accessor, so that each accessor records its failures separately
+	template<EPlayerAccessor Accessor>
+	UServiceLocatorContainer* GetCachedPlayerContainer(const TCHAR* AccessorName, const UObject* PlayerObject, const FServiceLookupCaller& Caller)
+	{
+		const uint32 ContainersGeneration = FServiceLocatorContainerRegistry::GetContainersGeneration();
+
+		const FPlayerContainerAnnotation CachedAnnotation = PlayerContainerAnnotations.GetAnnotation(PlayerObject);
+		UServiceLocatorContainer* CachedContainer = CachedAnnotation.Container.Get();
+		if ((CachedAnnotation.ContainersGeneration == ContainersGeneration) && IsValid(CachedContainer))
+		{
+			return CachedContainer;
+		}
+
+		const IServiceLocatorInterface* PlayerObjectAsSLI = Cast<const IServiceLocatorInterface>(PlayerObject);
+		if (PlayerObjectAsSLI == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, AccessorName, TEXT("Player object does not implement IServiceLocatorInterface!"), nullptr,
+				TEXT("%s: '%s' does not implement IServiceLocatorInterface!"), AccessorName, *GetNameSafe(PlayerObject));
+			return nullptr;
+		}
+
+		UServiceLocatorContainer* Container = PlayerObjectAsSLI->GetContainer();
+		if (Container == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, AccessorName, TEXT("Player object did not return a UServiceLocatorContainer!"), nullptr,
+				TEXT("%s: '%s' did not return a UServiceLocatorContainer!"), AccessorName, *GetNameSafe(PlayerObject));
+			return nullptr;
+		}
+
+		PlayerContainerAnnotations.AddAnnotation(PlayerObject, FPlayerContainerAnnotation{ Container, ContainersGeneration });
+		return Container;
+	}
+
+	APlayerController* GetPlayerControllerFromPlayerContextObject(const UObject* PlayerContextObject)
+	{
+		if (const APlayerController* PlayerController = Cast<const APlayerController>(PlayerContextObject))
+			return const_cast<APlayerController*>(PlayerController);
+
+		if (const APawn* Pawn = Cast<const APawn>(PlayerContextObject))
+			return Cast<APlayerController>(Pawn->GetController());
+
+		if (const APlayerState* PlayerState = Cast<const APlayerState>(PlayerContextObject))
+			return Cast<APlayerController>(PlayerState->GetOwner());
+
+		if (const ULocalPlayer* LocalPlayer = Cast<const ULocalPlayer>(PlayerContextObject))
+			return LocalPlayer->PlayerController;
+
+		return nullptr;
+	}
+
+	const IServiceLocatorInterface* GetGameStateService_GetGameStateSLIFromWorldContextObject(const UObject* WorldContextObject, const FServiceLookupCaller& Caller)
 	{
 		if (WorldContextObject == nullptr)
 		{
-			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("GetGameStateService: WorldContextObject is null!"));
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetGameStateService"), TEXT("WorldContextObject is null!"), nullptr,
+				TEXT("GetGameStateService: WorldContextObject is null!"));
 			return nullptr;
 		}
 
 		UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
 		if (World == nullptr)
 		{
-			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("GetGameStateService: Could not obtain World from context object '%s'"), *GetNameSafe(WorldContextObject));
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetGameStateService"), TEXT("Could not obtain World from context object"), nullptr,
+				TEXT("GetGameStateService: Could not obtain World from context object '%s'"), *GetNameSafe(WorldContextObject));
 			return nullptr;
 		}
 
@@ -40,32 +124,36 @@ namespace ServiceLocatorAccessors_Private
 		AGameStateBase* GameStateBase = World->GetGameState();
 		if (GameStateBase == nullptr)
 		{
-			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("GetGameStateService: Could not obtain Game State from World '%s'"), *GetNameSafe(World));
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetGameStateService"), TEXT("Could not obtain Game State from World"), nullptr,
+				TEXT("GetGameStateService: Could not obtain Game State from World '%s'"), *GetNameSafe(World));
 			return nullptr;
 		}
 
 		const IServiceLocatorInterface* GameStateAsSLI = Cast<const IServiceLocatorInterface>(GameStateBase);
 		if (GameStateAsSLI == nullptr)
 		{
-			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("GetGameStateService: GameStateBase '%s' does not implement IServiceLocatorInterface!"), *GetNameSafe(GameStateBase));
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetGameStateService"), TEXT("GameStateBase does not implement IServiceLocatorInterface!"), nullptr,
+				TEXT("GetGameStateService: GameStateBase '%s' does not implement IServiceLocatorInterface!"), *GetNameSafe(GameStateBase));
 			return nullptr;
 		}
 
 		return GameStateAsSLI;
 	}
 
-	const IServiceLocatorInterface* GetGameModeService_GetGameModeSLIFromWorldContextObject(const UObject* WorldContextObject)
+	const IServiceLocatorInterface* GetGameModeService_GetGameModeSLIFromWorldContextObject(const UObject* WorldContextObject, const FServiceLookupCaller& Caller)
 	{
 		if (WorldContextObject == nullptr)
 		{
-			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("GetGameModeService: WorldContextObject is null!"));
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetGameModeService"), TEXT("WorldContextObject is null!"), nullptr,
+				TEXT("GetGameModeService: WorldContextObject is null!"));
 			return nullptr;
 		}
 
 		UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
 		if (World == nullptr)
 		{
-			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("GetGameModeService: Could not obtain World from context object '%s'"), *GetNameSafe(WorldContextObject));
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetGameModeService"), TEXT("Could not obtain World from context object"), nullptr,
+				TEXT("GetGameModeService: Could not obtain World from context object '%s'"), *GetNameSafe(WorldContextObject));
 			return nullptr;
 		}
 
@@ -78,20 +166,132 @@ namespace ServiceLocatorAccessors_Private
 		AGameModeBase* GameModeBase = World->GetAuthGameMode();
 		if (GameModeBase == nullptr)
 		{
-			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("GetGameModeService: Could not obtain Game Mode from World '%s'"), *GetNameSafe(World));
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetGameModeService"), TEXT("Could not obtain Game Mode from World"), nullptr,
+				TEXT("GetGameModeService: Could not obtain Game Mode from World '%s'"), *GetNameSafe(World));
 			return nullptr;
 		}
 
 		const IServiceLocatorInterface* GameModeAsSLI = Cast<const IServiceLocatorInterface>(GameModeBase);
 		if (GameModeAsSLI == nullptr)
 		{
-			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("GetGameModeService: GameModeBase '%s' does not implement IServiceLocatorInterface!"), *GetNameSafe(GameModeBase));
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetGameModeService"), TEXT("GameModeBase does not implement IServiceLocatorInterface!"), nullptr,
+				TEXT("GetGameModeService: GameModeBase '%s' does not implement IServiceLocatorInterface!"), *GetNameSafe(GameModeBase));
 			return nullptr;
 		}
 
 		return GameModeAsSLI;
 	}
 
+	UServiceLocatorContainer* GetWorldService_GetRootContainerFromWorldContextObject(const UObject* WorldContextObject, const FServiceLookupCaller& Caller)
+	{
+		if (WorldContextObject == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetWorldService"), TEXT("WorldContextObject is null!"), nullptr,
+				TEXT("GetWorldService: WorldContextObject is null!"));
+			return nullptr;
+		}
+
+		UWorld* const World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+		if (World == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetWorldService"), TEXT("Could not obtain World from context object"), nullptr,
+				TEXT("GetWorldService: Could not obtain World from context object '%s'"), *GetNameSafe(WorldContextObject));
+			return nullptr;
+		}
+
+		UServiceLocatorContainer* RootContainer = FServiceLocatorWorldRegistry::GetRootContainer(World);
+		if (RootContainer == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetWorldService"), TEXT("World has no root container"), nullptr,
+				TEXT("GetWorldService: World '%s' has no root container"), *GetNameSafe(World));
+			return nullptr;
+		}
+
+		return RootContainer;
+	}
+
+	UServiceLocatorContainer* GetPlayerStateService_GetPlayerStateContainerFromPlayerContextObject(const UObject* PlayerContextObject, const FServiceLookupCaller& Caller)
+	{
+		if (PlayerContextObject == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetPlayerStateService"), TEXT("PlayerContextObject is null!"), nullptr,
+				TEXT("GetPlayerStateService: PlayerContextObject is null!"));
+			return nullptr;
+		}
+
+		const APlayerState* PlayerState = Cast<const APlayerState>(PlayerContextObject);
+		if (PlayerState == nullptr)
+		{
+			if (const APawn* Pawn = Cast<const APawn>(PlayerContextObject))
+			{
+				PlayerState = Pawn->GetPlayerState();
+			}
+			else if (const AController* Controller = Cast<const AController>(PlayerContextObject))
+			{
+				PlayerState = Controller->PlayerState;
+			}
+			else if (const ULocalPlayer* LocalPlayer = Cast<const ULocalPlayer>(PlayerContextObject))
+			{
+				PlayerState = (LocalPlayer->PlayerController != nullptr) ? LocalPlayer->PlayerController->PlayerState : nullptr;
+			}
+		}
+
+		if (PlayerState == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetPlayerStateService"), TEXT("Could not obtain Player State from player context object"), nullptr,
+				TEXT("GetPlayerStateService: Could not obtain Player State from player context object '%s'"), *GetNameSafe(PlayerContextObject));
+			return nullptr;
+		}
+
+		return GetCachedPlayerContainer<EPlayerAccessor::PlayerState>(TEXT("GetPlayerStateService"), PlayerState, Caller);
+	}
+
+	UServiceLocatorContainer* GetPlayerControllerService_GetPlayerControllerContainerFromPlayerContextObject(const UObject* PlayerContextObject, const FServiceLookupCaller& Caller)
+	{
+		if (PlayerContextObject == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetPlayerControllerService"), TEXT("PlayerContextObject is null!"), nullptr,
+				TEXT("GetPlayerControllerService: PlayerContextObject is null!"));
+			return nullptr;
+		}
+
+		const APlayerController* PlayerController = GetPlayerControllerFromPlayerContextObject(PlayerContextObject);
+		if (PlayerController == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetPlayerControllerService"), TEXT("Could not obtain Player Controller from player context object"), nullptr,
+				TEXT("GetPlayerControllerService: Could not obtain Player Controller from player context object '%s'"), *GetNameSafe(PlayerContextObject));
+			return nullptr;
+		}
+
+		return GetCachedPlayerContainer<EPlayerAccessor::PlayerController>(TEXT("GetPlayerControllerService"), PlayerController, Caller);
+	}
+
+	UServiceLocatorContainer* GetLocalPlayerService_GetLocalPlayerContainerFromPlayerContextObject(const UObject* PlayerContextObject, const FServiceLookupCaller& Caller)
+	{
+		if (PlayerContextObject == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetLocalPlayerService"), TEXT("PlayerContextObject is null!"), nullptr,
+				TEXT("GetLocalPlayerService: PlayerContextObject is null!"));
+			return nullptr;
+		}
+
+		const ULocalPlayer* LocalPlayer = Cast<const ULocalPlayer>(PlayerContextObject);
+		if (LocalPlayer == nullptr)
+		{
+			const APlayerController* PlayerController = GetPlayerControllerFromPlayerContextObject(PlayerContextObject);
+			LocalPlayer = (PlayerController != nullptr) ? PlayerController->GetLocalPlayer() : nullptr;
+		}
+
+		if (LocalPlayer == nullptr)
+		{
+			SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("GetLocalPlayerService"), TEXT("Could not obtain Local Player from player context object, it may not be locally controlled"), nullptr,
+				TEXT("GetLocalPlayerService: Could not obtain Local Player from player context object '%s', it may not be locally controlled"), *GetNameSafe(PlayerContextObject));
+			return nullptr;
+		}
+
+		return GetCachedPlayerContainer<EPlayerAccessor::LocalPlayer>(TEXT("GetLocalPlayerService"), LocalPlayer, Caller);
+	}
+
 } // namespace ServiceLocatorAccessors_Private
 
 ///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorClassCache.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocator
+#include "ServiceLocatorClassCache.h"
+#include "ServiceLocatorConfig.h"
+#include "ServiceLocatorContainer.h"
+
+// Engine
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorClassCache_Private
+{
+
+	FRWLock ConfigLayoutsLock;
+	TMap<FObjectKey, FServiceConfigLayoutRef> ConfigLayouts;
+
+	FDelegateHandle PostGarbageCollectHandle;
+#if WITH_EDITOR
+	FDelegateHandle ObjectsReplacedHandle;
+#endif
+
+	bool IsLayoutStale(const FServiceConfigLayout& ConfigLayout)
+	{
+		for (const FServiceDescriptorLayout& DescriptorLayout : ConfigLayout.Descriptors)
+		{
+			if (DescriptorLayout.bValidServiceType && !DescriptorLayout.ServiceType.IsValid())
+			{
+				return true;
+			}
+
+			for (const FServiceMappedTypeLayout& MappedTypeLayout : DescriptorLayout.MappedTypes)
+			{
+				if (!MappedTypeLayout.MappedType.IsValid())
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	int32 CountUnresolvedClasses(const UServiceLocatorConfig* Config)
+	{
+		int32 NumUnresolvedClasses = 0;
+
+		for (const FServiceDescriptor& ServiceDescriptor : Config->ServiceDescriptors)
+		{
+			if (ServiceDescriptor.ServiceType.IsPending())
+			{
+				++NumUnresolvedClasses;
+				continue;
+			}
+
+			for (const TSoftClassPtr<UObject>& MappedType : ServiceDescriptor.MappedTypes)
+			{
+				NumUnresolvedClasses += MappedType.IsPending() ? 1 : 0;
+			}
+		}
+
+		return NumUnresolvedClasses;
+	}
+
+	FServiceConfigLayoutRef BuildConfigLayout(const UServiceLocatorConfig* Config)
+	{
+		TSharedRef<FServiceConfigLayout, ESPMode::ThreadSafe> ConfigLayout = MakeShared<FServiceConfigLayout, ESPMode::ThreadSafe>();
+		ConfigLayout->Descriptors.SetNum(Config->ServiceDescriptors.Num());
+
+		for (int32 DescriptorIndex = 0; DescriptorIndex < Config->ServiceDescriptors.Num(); ++DescriptorIndex)
+		{
+			const FServiceDescriptor& ServiceDescriptor = Config->ServiceDescriptors[DescriptorIndex];
+			FServiceDescriptorLayout& DescriptorLayout = ConfigLayout->Descriptors[DescriptorIndex];
+
+			UClass* ServiceType = ServiceDescriptor.GetServiceType();
+			if (ServiceDescriptor.ServiceType.IsPending())
+			{
+				// Not an error, the class may be loaded later on, at which point the layout is rebuilt
+				UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("FServiceLocatorClassCache::BuildConfigLayout: ServiceType '%s' isn't loaded for element '%d' in config '%s'"),
+					*ServiceDescriptor.ServiceType.ToString(), DescriptorIndex, *GetNameSafe(Config));
+				continue;
+			}
+
+			if (ServiceType == nullptr)
+			{
+				UE_LOG(LogUnrealServiceLocator, Warning, TEXT("FServiceLocatorClassCache::BuildConfigLayout: ServiceType is null for element '%d' in config '%s'"),
+					DescriptorIndex, *GetNameSafe(Config));
+				continue;
+			}
+
+			if (ServiceType->HasAnyClassFlags(CLASS_Abstract | CLASS_Interface))
+			{
+				UE_LOG(LogUnrealServiceLocator, Warning, TEXT("FServiceLocatorClassCache::BuildConfigLayout: ServiceType has Abstract or Interface class flags for element '%d' in config '%s'"),
+					DescriptorIndex, *GetNameSafe(Config));
+				continue;
+			}
+
+			DescriptorLayout.bValidServiceType = true;
+			DescriptorLayout.ServiceType = ServiceType;
+
+			for (const TSoftClassPtr<UObject>& MappedTypePtr : ServiceDescriptor.MappedTypes)
+			{
+				UClass* MappedType = MappedTypePtr.Get();
+				if (MappedType == nullptr)
+				{
+					continue;
+				}
+
+				FServiceMappedTypeLayout MappedTypeLayout;
+				MappedTypeLayout.MappedType = MappedType;
+
+				if (MappedType->HasAnyClassFlags(CLASS_Interface))
+				{
+					if (!ServiceType->ImplementsInterface(MappedType))
+					{
+						UE_LOG(LogUnrealServiceLocator, Error, TEXT("FServiceLocatorClassCache::BuildConfigLayout: ServiceType '%s' doesn't implement MappedType '%s'"),
+							*GetNameSafe(ServiceType), *GetNameSafe(MappedType));
+						continue;
+					}
+
+				}
+				else if (!ServiceType->IsChildOf(MappedType))
+				{
+					UE_LOG(LogUnrealServiceLocator, Error, TEXT("FServiceLocatorClassCache::BuildConfigLayout: ServiceType '%s' isn't a child of MappedType '%s'"),
+						*GetNameSafe(ServiceType), *GetNameSafe(MappedType));
+					continue;
+				}
+
+				DescriptorLayout.MappedTypes.Emplace(MappedTypeLayout);
+			}
+		}
+
+		ConfigLayout->NumUnresolvedClasses = CountUnresolvedClasses(Config);
+
+		return ConfigLayout;
+	}
+
+} // namespace ServiceLocatorClassCache_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorClassCache::Startup()
+{
+	using namespace ServiceLocatorClassCache_Private;
+
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&FServiceLocatorClassCache::EvictStaleLayouts);
+
+#if WITH_EDITOR
+	// Reinstanced classes keep their layout valid in shape, but may no longer be compatible with the mapped types
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>& /* ReplacementMap */)
+	{
+		FServiceLocatorClassCache::Reset();
+	});
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorClassCache::Shutdown()
+{
+	using namespace ServiceLocatorClassCache_Private;
+
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	PostGarbageCollectHandle.Reset();
+
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+	ObjectsReplacedHandle.Reset();
+#endif
+
+	Reset();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+FServiceConfigLayoutRef FServiceLocatorClassCache::GetConfigLayout(const UServiceLocatorConfig* Config)
+{
+	using namespace ServiceLocatorClassCache_Private;
+
+	check(Config != nullptr);
+
+	const FObjectKey ConfigKey(Config);
+	const int32 NumDescriptors = Config->ServiceDescriptors.Num();
+
+	{
+		FReadScopeLock ReadScopeLock(ConfigLayoutsLock);
+
+		// Stale layouts are normally evicted after garbage collection, but a class may be destroyed in between
+		const FServiceConfigLayoutRef* ConfigLayout = ConfigLayouts.Find(ConfigKey);
+		if ((ConfigLayout != nullptr) && ((*ConfigLayout)->Descriptors.Num() == NumDescriptors) && !IsLayoutStale(**ConfigLayout)
+			&& (((*ConfigLayout)->NumUnresolvedClasses == 0) || ((*ConfigLayout)->NumUnresolvedClasses == CountUnresolvedClasses(Config))))
+		{
+			return *ConfigLayout;
+		}
+	}
+
+	// Built outside the lock, so that other configs can still be read meanwhile. If two threads race to build the
+	// same layout, both results are identical, and the last one wins.
+	FServiceConfigLayoutRef ConfigLayout = BuildConfigLayout(Config);
+
+	FWriteScopeLock WriteScopeLock(ConfigLayoutsLock);
+	ConfigLayouts.Emplace(ConfigKey, ConfigLayout);
+
+	return ConfigLayout;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorClassCache::Invalidate(const UServiceLocatorConfig* Config)
+{
+	using namespace ServiceLocatorClassCache_Private;
+
+	FWriteScopeLock WriteScopeLock(ConfigLayoutsLock);
+	ConfigLayouts.Remove(FObjectKey(Config));
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorClassCache::Reset()
+{
+	using namespace ServiceLocatorClassCache_Private;
+
+	FWriteScopeLock WriteScopeLock(ConfigLayoutsLock);
+	ConfigLayouts.Empty();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorClassCache::EvictStaleLayouts()
+{
+	using namespace ServiceLocatorClassCache_Private;
+
+	FWriteScopeLock WriteScopeLock(ConfigLayoutsLock);
+
+	for (auto Iter = ConfigLayouts.CreateIterator(); Iter; ++Iter)
+	{
+		if ((Iter.Key().ResolveObjectPtr() == nullptr) || IsLayoutStale(*Iter.Value()))
+		{
+			Iter.RemoveCurrent();
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
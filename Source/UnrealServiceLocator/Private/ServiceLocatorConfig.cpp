@@ -4,12 +4,158 @@
 
 // UnrealServiceLocator
 #include "ServiceLocatorConfig.h"
+#include "ServiceLocatorClassCache.h"
+#include "ServiceLocatorInjection.h"
+#include "ServiceLocatorNativeRegistry.h"
 
 // Engine
 // ...
 
 ///////////////////////////////////////////////////////////////////////////
 
+void UServiceLocatorConfig::ResolveDescriptorClasses(TArrayView<const FServiceDescriptor> ServiceDescriptors, FServiceDescriptorClasses& OutClasses)
+{
+	// Resolving a soft pointer may search for the object, which isn't safe off the game thread
+	check(IsInGameThread());
 
+	OutClasses.ServiceTypes.Reset(ServiceDescriptors.Num());
+	OutClasses.MappedTypes.Reset(ServiceDescriptors.Num());
+	OutClasses.InjectionPoints.Reset(ServiceDescriptors.Num());
 
-///////////////////////////////////////////////////////////////////////////
\ No newline at end of file
+	for (const FServiceDescriptor& ServiceDescriptor : ServiceDescriptors)
+	{
+		UClass* ServiceType = ServiceDescriptor.GetServiceType();
+		OutClasses.ServiceTypes.Add(ServiceType);
+
+		// Reading injection metadata isn't safe off the game thread either, so injection points are resolved here too
+		FServiceInjectionPoints& InjectionPoints = OutClasses.InjectionPoints.AddDefaulted_GetRef();
+		if (ServiceType != nullptr)
+		{
+			FServiceLocatorInjection::FindInjectionPoints(ServiceType, InjectionPoints);
+		}
+
+		TArray<UClass*>& MappedTypes = OutClasses.MappedTypes.AddDefaulted_GetRef();
+		MappedTypes.Reserve(ServiceDescriptor.MappedTypes.Num());
+
+		for (const TSoftClassPtr<UObject>& MappedTypePtr : ServiceDescriptor.MappedTypes)
+		{
+			MappedTypes.Add(MappedTypePtr.Get());
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorConfig::ValidateDescriptors(TArrayView<const FServiceDescriptor> ServiceDescriptors, FServiceConfigValidation& OutValidation)
+{
+	FServiceDescriptorClasses Classes;
+	ResolveDescriptorClasses(ServiceDescriptors, Classes);
+	ValidateDescriptors(ServiceDescriptors, Classes, OutValidation);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorConfig::ValidateDescriptors(TArrayView<const FServiceDescriptor> ServiceDescriptors, const FServiceDescriptorClasses& Classes, FServiceConfigValidation& OutValidation)
+{
+	check(Classes.ServiceTypes.Num() == ServiceDescriptors.Num());
+	check(Classes.MappedTypes.Num() == ServiceDescriptors.Num());
+	check(Classes.InjectionPoints.Num() == ServiceDescriptors.Num());
+
+	auto AddIssue = [&OutValidation](int32 DescriptorIndex, bool bError, FString&& Message)
+	{
+		OutValidation.Issues.Emplace(FServiceConfigValidationIssue{ DescriptorIndex, bError, MoveTemp(Message) });
+	};
+
+	// The descriptor each type (and key) ends up mapped to, as later descriptors displace earlier ones
+	TMap<TPair<UClass*, FName>, int32> MappedTypeDescriptorIndices;
+
+	for (int32 DescriptorIndex = 0; DescriptorIndex < ServiceDescriptors.Num(); ++DescriptorIndex)
+	{
+		const FServiceDescriptor& ServiceDescriptor = ServiceDescriptors[DescriptorIndex];
+
+		// Only the soft paths are read from here on, as they're plain data, unlike resolving them
+		UClass* ServiceType = Classes.ServiceTypes[DescriptorIndex];
+		if ((ServiceType == nullptr) && !ServiceDescriptor.ServiceType.IsNull())
+		{
+			AddIssue(DescriptorIndex, true, FString::Printf(TEXT("ServiceType '%s' isn't loaded"), *ServiceDescriptor.ServiceType.ToString()));
+			continue;
+		}
+
+		if (ServiceType == nullptr)
+		{
+			AddIssue(DescriptorIndex, true, TEXT("ServiceType is null"));
+			continue;
+		}
+
+		if (ServiceType->HasAnyClassFlags(CLASS_Abstract | CLASS_Interface))
+		{
+			AddIssue(DescriptorIndex, true, FString::Printf(TEXT("ServiceType '%s' has Abstract or Interface class flags"), *ServiceType->GetName()));
+			continue;
+		}
+
+		if (ServiceDescriptor.MappedTypes.Num() == 0)
+		{
+			AddIssue(DescriptorIndex, false, FString::Printf(TEXT("ServiceType '%s' has no MappedTypes, so can't be retrieved"), *ServiceType->GetName()));
+		}
+
+		const FName ServiceKey = ServiceDescriptor.GetServiceKey();
+
+		const TArray<UClass*>& MappedTypes = Classes.MappedTypes[DescriptorIndex];
+		check(MappedTypes.Num() == ServiceDescriptor.MappedTypes.Num());
+
+		for (int32 MappedTypeIndex = 0; MappedTypeIndex < MappedTypes.Num(); ++MappedTypeIndex)
+		{
+			const TSoftClassPtr<UObject>& MappedTypePtr = ServiceDescriptor.MappedTypes[MappedTypeIndex];
+			UClass* MappedType = MappedTypes[MappedTypeIndex];
+			if (MappedType == nullptr)
+			{
+				const bool bPending = !MappedTypePtr.IsNull();
+				AddIssue(DescriptorIndex, bPending, bPending ? FString::Printf(TEXT("MappedType '%s' isn't loaded"), *MappedTypePtr.ToString()) : FString(TEXT("MappedType is null")));
+				continue;
+			}
+
+			const bool bCompatible = MappedType->HasAnyClassFlags(CLASS_Interface) ? ServiceType->ImplementsInterface(MappedType) : ServiceType->IsChildOf(MappedType);
+			if (!bCompatible)
+			{
+				AddIssue(DescriptorIndex, true, FString::Printf(TEXT("ServiceType '%s' doesn't implement or derive from MappedType '%s'"), *ServiceType->GetName(), *MappedType->GetName()));
+				continue;
+			}
+
+			int32& MappedDescriptorIndex = MappedTypeDescriptorIndices.FindOrAdd(TPair<UClass*, FName>(MappedType, ServiceKey), INDEX_NONE);
+			if ((MappedDescriptorIndex != INDEX_NONE) && (MappedDescriptorIndex != DescriptorIndex))
+			{
+				OutValidation.Displacements.Emplace(FServiceConfigDisplacement{ MappedType, ServiceKey, MappedDescriptorIndex, DescriptorIndex });
+			}
+
+			MappedDescriptorIndex = DescriptorIndex;
+		}
+	}
+
+	// Dependencies are resolved once every mapping is known, as a service may depend on one which comes after it
+	for (int32 DescriptorIndex = 0; DescriptorIndex < ServiceDescriptors.Num(); ++DescriptorIndex)
+	{
+		for (const FServiceInjectionPoint& InjectionPoint : Classes.InjectionPoints[DescriptorIndex])
+		{
+			const int32* DependencyDescriptorIndex = MappedTypeDescriptorIndices.Find(TPair<UClass*, FName>(InjectionPoint.ServiceType, InjectionPoint.ServiceKey));
+			OutValidation.Dependencies.Emplace(FServiceConfigDependency{ DescriptorIndex, InjectionPoint.ServiceType, InjectionPoint.ServiceKey,
+				(DependencyDescriptorIndex != nullptr) ? *DependencyDescriptorIndex : INDEX_NONE });
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+#if WITH_EDITOR
+
+void UServiceLocatorConfig::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Containers pick up the rebuilt layout the next time they locate services
+	FServiceLocatorClassCache::Invalidate(this);
+	FServiceLocatorNativeRegistry::InvalidateMergedConfigs();
+}
+
+#endif // WITH_EDITOR
+
+///////////////////////////////////////////////////////////////////////////
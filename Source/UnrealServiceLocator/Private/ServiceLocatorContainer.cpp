@@ -4,11 +4,36 @@
 
 // UnrealServiceLocator
 #include "ServiceLocatorContainer.h"
+#include "ServiceLocatorClassCache.h"
+#include "ServiceLocatorInjection.h"
+#include "ServiceLocatorNativeRegistry.h"
 #include "ServiceLocatorConfig.h"
+#include "ServiceLocatorContainerRegistry.h"
+#include "ServiceLocatorFactory.h"
+#include "ServiceLocatorTypes.h"
+#include "ServiceLocatorWorldRegistry.h"
+#include "ServiceShutdownInterface.h"
+#include "ServiceTickInterface.h"
+#include "ServiceWarmUpInterface.h"
 
 // Engine
 #include "EngineUtils.h"
+#include "Async/Async.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Algo/Reverse.h"
+#include "Async/ParallelFor.h"
+#include "Components/ActorComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 #include "Stats/Stats2.h"
 
 ///////////////////////////////////////////////////////////////////////////
@@ -22,9 +47,23 @@ DEFINE_LOG_CATEGORY(LogUnrealServiceLocator);
 DECLARE_STATS_GROUP(TEXT("UnrealServiceLocator"), STATGROUP_UnrealServiceLocator, STATCAT_Advanced);
 DECLARE_DWORD_COUNTER_STAT(TEXT("UServiceLocatorContainer::GetServiceInternal Frame Calls"), STAT_UServiceLocatorContainer_GetServiceInternal_FrameCalls, STATGROUP_UnrealServiceLocator);
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("UServiceLocatorContainer::GetServiceInternal Total Calls"), STAT_UServiceLocatorContainer_GetServiceInternal_TotalCalls, STATGROUP_UnrealServiceLocator);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UServiceLocatorContainer Queued Service Calls Frame Calls"), STAT_UServiceLocatorContainer_QueuedServiceCalls_FrameCalls, STATGROUP_UnrealServiceLocator);
 DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::GetServiceInternal"), STAT_UServiceLocatorContainer_GetServiceInternal, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::FlushQueuedServiceCalls"), STAT_UServiceLocatorContainer_FlushQueuedServiceCalls, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::TickServices"), STAT_UServiceLocatorContainer_TickServices, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::DispatchServiceEvents"), STAT_UServiceLocatorContainer_DispatchServiceEvents, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::ShutdownServices"), STAT_UServiceLocatorContainer_ShutdownServices, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::RecoverService"), STAT_UServiceLocatorContainer_RecoverService, STATGROUP_UnrealServiceLocator);
 DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::LocateAndCreateServices"), STAT_UServiceLocatorContainer_LocateAndCreateServices, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::LoadServiceClasses"), STAT_UServiceLocatorContainer_LoadServiceClasses, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::InjectServices"), STAT_UServiceLocatorContainer_InjectServices, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::WarmUpService"), STAT_UServiceLocatorContainer_WarmUpService, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::SaveServicesSnapshot"), STAT_UServiceLocatorContainer_SaveServicesSnapshot, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::RestoreServicesFromSnapshot"), STAT_UServiceLocatorContainer_RestoreServicesFromSnapshot, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::HandleLevelAddedToWorld"), STAT_UServiceLocatorContainer_HandleLevelAddedToWorld, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::TickAsyncLocate"), STAT_UServiceLocatorContainer_TickAsyncLocate, STATGROUP_UnrealServiceLocator);
 DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::LocateOrCreateActorService"), STAT_UServiceLocatorContainer_LocateOrCreateActorService, STATGROUP_UnrealServiceLocator);
+DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::FinishSpawningActorServices"), STAT_UServiceLocatorContainer_FinishSpawningActorServices, STATGROUP_UnrealServiceLocator);
 DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::LocateOrCreateComponentService"), STAT_UServiceLocatorContainer_LocateOrCreateComponentService, STATGROUP_UnrealServiceLocator);
 DECLARE_CYCLE_STAT(TEXT("UServiceLocatorContainer::LocateOrCreateObjectService"), STAT_UServiceLocatorContainer_LocateOrCreateObjectService, STATGROUP_UnrealServiceLocator);
 
@@ -34,125 +73,2391 @@ void UServiceLocatorContainer::LocateAndCreateServices()
 {
 	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_LocateAndCreateServices);
 
-	if (Config == nullptr)
+	if (!IsLocatingServices())
+	{
+		ResolveActiveConfig();
+	}
+
+	if (ActiveConfig == nullptr)
 	{
 		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateServices: Config is null on container '%s' with outer '%s'"),
 			*GetNameSafe(this), *GetNameSafe(GetOuter()));
 		return;
 	}
 
-	const TArray<FServiceDescriptor>& ServiceDescriptors = Config->ServiceDescriptors;
+	if (!IsLocatingServices())
+	{
+		EvaluateDescriptorConditions();
+		LoadServiceClassesSynchronous();
+	}
+
+	// Synchronous location supersedes any asynchronous location that is still in flight
+	const int32 FirstDescriptorIndex = IsLocatingServices() ? AsyncDescriptorIndex : 0;
+	const bool bSkipCriticalServices = IsLocatingServices();
+	AsyncDescriptorIndex = INDEX_NONE;
+
+	const TArray<FServiceDescriptor>& ServiceDescriptors = ActiveConfig->ServiceDescriptors;
+
+	TGuardValue<bool> DeferActorServiceSpawning(bDeferActorServiceSpawning, true);
+
+	// Inactive descriptors are never visited
+	for (TConstSetBitIterator<> ActiveIt(ActiveDescriptors, FMath::Min(FirstDescriptorIndex, ActiveDescriptors.Num())); ActiveIt; ++ActiveIt)
+	{
+		const int32 DescriptorIndex = ActiveIt.GetIndex();
+		if (!ServiceDescriptors.IsValidIndex(DescriptorIndex))
+		{
+			break;
+		}
+
+		const FServiceDescriptor& ServiceDescriptor = ServiceDescriptors[DescriptorIndex];
+		if (bSkipCriticalServices && ServiceDescriptor.bCritical)
+		{
+			continue;
+		}
+
+		LocateAndCreateService(ServiceDescriptor, DescriptorIndex);
+	}
+
+	FinishSpawningActorServices();
+	FinishLocatingServices();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::LocateAndCreateServicesAsync()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_LocateAndCreateServices);
+
+	if (IsLocatingServices())
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateAndCreateServicesAsync: Container '%s' with outer '%s' is already locating services"),
+			*GetNameSafe(this), *GetNameSafe(GetOuter()));
+		return;
+	}
+
+	ResolveActiveConfig();
+
+	if (ActiveConfig == nullptr)
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateAndCreateServicesAsync: Config is null on container '%s' with outer '%s'"),
+			*GetNameSafe(this), *GetNameSafe(GetOuter()));
+		return;
+	}
+
+	EvaluateDescriptorConditions();
+	LoadServiceClassesSynchronous();
+
+	const TArray<FServiceDescriptor>& ServiceDescriptors = ActiveConfig->ServiceDescriptors;
+
+	TGuardValue<bool> DeferActorServiceSpawning(bDeferActorServiceSpawning, true);
+
+	// Critical services are located up front, everything else is deferred and reported as pending until it has been processed
+	for (TConstSetBitIterator<> ActiveIt(ActiveDescriptors); ActiveIt; ++ActiveIt)
+	{
+		const int32 DescriptorIndex = ActiveIt.GetIndex();
+		const FServiceDescriptor& ServiceDescriptor = ServiceDescriptors[DescriptorIndex];
+		if (ServiceDescriptor.bCritical)
+		{
+			LocateAndCreateService(ServiceDescriptor, DescriptorIndex);
+			continue;
+		}
+
+		for (const TSoftClassPtr<UObject>& MappedType : ServiceDescriptor.MappedTypes)
+		{
+			if (UClass* LoadedMappedType = MappedType.Get())
+			{
+				PendingMappedTypes.Emplace(LoadedMappedType);
+			}
+		}
+	}
+
+	FinishSpawningActorServices();
+
+	AsyncDescriptorIndex = 0;
+	StartTicking();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorContainer_Private
+{
+
+	FStreamableManager& GetStreamableManager()
+	{
+		if (UAssetManager::IsValid())
+		{
+			return UAssetManager::GetStreamableManager();
+		}
+
+		static FStreamableManager StreamableManager;
+		return StreamableManager;
+	}
+
+} // namespace ServiceLocatorContainer_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::LoadAndLocateServicesAsync(bool bLocateAsync)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_LoadServiceClasses);
+
+	if (IsLoadingServiceClasses())
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LoadAndLocateServicesAsync: Container '%s' with outer '%s' is already loading service classes"),
+			*GetNameSafe(this), *GetNameSafe(GetOuter()));
+		return;
+	}
+
+	// Resolved again when location starts, in case more native services have been registered while classes were loading
+	ResolveActiveConfig();
+
+	if (ActiveConfig == nullptr)
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LoadAndLocateServicesAsync: Config is null on container '%s' with outer '%s'"),
+			*GetNameSafe(this), *GetNameSafe(GetOuter()));
+		return;
+	}
+
+	bLocateAsyncOnceLoaded = bLocateAsync;
+
+	EvaluateDescriptorConditions();
+
+	TArray<FSoftObjectPath> ServiceClassPaths;
+	GatherServiceClassesToLoad(ServiceClassPaths);
+
+	if (ServiceClassPaths.Num() == 0)
+	{
+		HandleServiceClassesLoaded();
+		return;
+	}
+
+	// Every class is requested at once, so that they're loaded in parallel
+	ServiceClassesHandle = ServiceLocatorContainer_Private::GetStreamableManager().RequestAsyncLoad(MoveTemp(ServiceClassPaths),
+		FStreamableDelegate::CreateUObject(this, &UServiceLocatorContainer::HandleServiceClassesLoaded), FStreamableManager::AsyncLoadHighPriority);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+bool UServiceLocatorContainer::IsLoadingServiceClasses() const
+{
+	return ServiceClassesHandle.IsValid() && ServiceClassesHandle->IsLoadingInProgress();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::HandleServiceClassesLoaded()
+{
+	if (bLocateAsyncOnceLoaded)
+	{
+		LocateAndCreateServicesAsync();
+	}
+	else
+	{
+		LocateAndCreateServices();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::LoadServiceClassesSynchronous()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_LoadServiceClasses);
+
+	TArray<FSoftObjectPath> ServiceClassPaths;
+	GatherServiceClassesToLoad(ServiceClassPaths);
+
+	for (const FSoftObjectPath& ServiceClassPath : ServiceClassPaths)
+	{
+		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LoadServiceClassesSynchronous: Loading service class '%s' synchronously for container '%s'"),
+			*ServiceClassPath.ToString(), *GetNameSafe(this));
+
+		ServiceClassPath.TryLoad();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorContainer_Private
+{
+
+	EServiceNetModeFlags GetNetModeFlag(const UWorld* World)
+	{
+		switch ((World != nullptr) ? World->GetNetMode() : NM_Standalone)
+		{
+			case NM_DedicatedServer:	return EServiceNetModeFlags::DedicatedServer;
+			case NM_ListenServer:		return EServiceNetModeFlags::ListenServer;
+			case NM_Client:				return EServiceNetModeFlags::Client;
+			default:					return EServiceNetModeFlags::Standalone;
+		}
+	}
+
+	EServiceBuildConfigurationFlags GetBuildConfigurationFlag()
+	{
+		switch (FApp::GetBuildConfiguration())
+		{
+			case EBuildConfiguration::Debug:
+			case EBuildConfiguration::DebugGame:	return EServiceBuildConfigurationFlags::Debug;
+			case EBuildConfiguration::Test:			return EServiceBuildConfigurationFlags::Test;
+			case EBuildConfiguration::Shipping:		return EServiceBuildConfigurationFlags::Shipping;
+			default:								return EServiceBuildConfigurationFlags::Development;
+		}
+	}
+
+	bool IsFeatureEnabled(FName Feature, TMap<FName, bool>& FeatureCache)
+	{
+		if (const bool* bCachedEnabled = FeatureCache.Find(Feature))
+		{
+			return *bCachedEnabled;
+		}
+
+		const FString FeatureName = Feature.ToString();
+
+		bool bEnabled = FParse::Param(FCommandLine::Get(), *FeatureName);
+		if (!bEnabled)
+		{
+			const IConsoleVariable* ConsoleVariable = IConsoleManager::Get().FindConsoleVariable(*FeatureName);
+			bEnabled = (ConsoleVariable != nullptr) && (ConsoleVariable->GetInt() != 0);
+		}
+
+		FeatureCache.Emplace(Feature, bEnabled);
+		return bEnabled;
+	}
+
+} // namespace ServiceLocatorContainer_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::ResolveActiveConfig()
+{
+	ActiveConfig = FServiceLocatorNativeRegistry::GetMergedConfig(Config, NativeServiceGroups);
+	ConfigLayout.Reset();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::EvaluateDescriptorConditions()
+{
+	using namespace ServiceLocatorContainer_Private;
+
+	const UWorld* LocalWorld = GetWorld();
+
+	CreatableLocateBehaviours = 1 << static_cast<uint8>(EServiceLocationBehaviour::CreateIfNotFound);
+	if (LocalWorld != nullptr)
+	{
+		const EServiceLocationBehaviour NetModeBehaviour = LocalWorld->IsServer() ? EServiceLocationBehaviour::CreateIfNotFoundServerOnly : EServiceLocationBehaviour::CreateIfNotFoundClientOnly;
+		CreatableLocateBehaviours |= 1 << static_cast<uint8>(NetModeBehaviour);
+	}
+
+	if (ActiveConfig == nullptr)
+	{
+		ActiveDescriptors.Empty();
+		return;
+	}
+
+	const TArray<FServiceDescriptor>& ServiceDescriptors = ActiveConfig->ServiceDescriptors;
+	ActiveDescriptors.Init(false, ServiceDescriptors.Num());
+
+	const int32 NetModeFlag = static_cast<int32>(GetNetModeFlag(LocalWorld));
+	const int32 BuildConfigurationFlag = static_cast<int32>(GetBuildConfigurationFlag());
+	const FString PlatformName = FPlatformProperties::IniPlatformName();
+	const AWorldSettings* WorldSettings = (LocalWorld != nullptr) ? LocalWorld->GetWorldSettings(false, false) : nullptr;
+
+	auto HasMapTag = [WorldSettings](FName Tag) { return (WorldSettings != nullptr) && WorldSettings->ActorHasTag(Tag); };
+
+	TMap<FName, bool> FeatureCache;
+	auto IsFeatureDisabled = [&FeatureCache](FName Feature) { return !IsFeatureEnabled(Feature, FeatureCache); };
+	auto IsFeatureEnabledCached = [&FeatureCache](FName Feature) { return IsFeatureEnabled(Feature, FeatureCache); };
+
+	for (int32 DescriptorIndex = 0; DescriptorIndex < ServiceDescriptors.Num(); ++DescriptorIndex)
+	{
+		const FServiceDescriptor& ServiceDescriptor = ServiceDescriptors[DescriptorIndex];
+		const FServiceConditions& Conditions = ServiceDescriptor.Conditions;
+
+		const bool bActive = !(ServiceDescriptor.bDebugOnly && UE_BUILD_SHIPPING)
+			&& ((Conditions.NetModes == 0) || ((Conditions.NetModes & NetModeFlag) != 0))
+			&& ((Conditions.BuildConfigurations == 0) || ((Conditions.BuildConfigurations & BuildConfigurationFlag) != 0))
+			&& ((Conditions.Platforms.Num() == 0) || Conditions.Platforms.Contains(PlatformName))
+			&& !Conditions.RequiredFeatures.ContainsByPredicate(IsFeatureDisabled)
+			&& !Conditions.ExcludedFeatures.ContainsByPredicate(IsFeatureEnabledCached)
+			&& !Conditions.RequiredMapTags.ContainsByPredicate([&HasMapTag](FName Tag) { return !HasMapTag(Tag); })
+			&& !Conditions.ExcludedMapTags.ContainsByPredicate(HasMapTag);
+
+		ActiveDescriptors[DescriptorIndex] = bActive;
+
+		if (!bActive)
+		{
+			UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::EvaluateDescriptorConditions: Skipping service '%s' in container '%s', as its conditions aren't met"),
+				*ServiceDescriptor.ServiceType.ToString(), *GetNameSafe(this));
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::GatherServiceClassesToLoad(TArray<FSoftObjectPath>& OutClassPaths) const
+{
+	if (ActiveConfig == nullptr)
+	{
+		return;
+	}
+
+	auto AddIfNotLoaded = [&OutClassPaths](const TSoftClassPtr<UObject>& Class)
+	{
+		if (Class.IsPending())
+		{
+			OutClassPaths.AddUnique(Class.ToSoftObjectPath());
+		}
+	};
+
+	for (TConstSetBitIterator<> ActiveIt(ActiveDescriptors); ActiveIt; ++ActiveIt)
+	{
+		if (!ActiveConfig->ServiceDescriptors.IsValidIndex(ActiveIt.GetIndex()))
+		{
+			break;
+		}
+
+		const FServiceDescriptor& ServiceDescriptor = ActiveConfig->ServiceDescriptors[ActiveIt.GetIndex()];
+
+		// A service which can only be found can't have an instance until its class has been loaded by something else
+		if (!CanCreateService(ServiceDescriptor))
+		{
+			continue;
+		}
+
+		AddIfNotLoaded(ServiceDescriptor.ServiceType);
+
+		for (const TSoftClassPtr<UObject>& MappedType : ServiceDescriptor.MappedTypes)
+		{
+			AddIfNotLoaded(MappedType);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::LocateAndCreateService(const FServiceDescriptor& ServiceDescriptor, int32 DescriptorIndex)
+{
+	// Invalid service types are reported once, when the config's layout is built
+	const FServiceDescriptorLayout* DescriptorLayout = GetDescriptorLayout(DescriptorIndex);
+	if ((DescriptorLayout == nullptr) || !DescriptorLayout->bValidServiceType)
+	{
+		// A FindOnly service whose class isn't loaded can't have an instance yet, but one may stream in along with its class
+		if ((ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::FindOnly) && ServiceDescriptor.ServiceType.IsPending())
+		{
+			AddPendingStreamedDescriptor(DescriptorIndex);
+		}
+		return;
+	}
+
+	// The class may have been unloaded since the layout was validated, e.g. a blueprint service whose package was unloaded
+	UClass* ServiceType = ServiceDescriptor.GetServiceType();
+	if (ServiceType == nullptr)
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateAndCreateService: ServiceType '%s' is no longer loaded for element '%d' in config '%s'"),
+			*ServiceDescriptor.ServiceType.ToString(), DescriptorIndex, *GetNameSafe(ActiveConfig));
+		return;
+	}
+
+	// Descriptors which are debug only in a shipping build, or whose conditions weren't met, are skipped
+	if (!IsDescriptorActive(DescriptorIndex))
+	{
+		return;
+	}
+
+	bool bCreated = false;
+	UObject* ServiceInstance = LocateOrCreateService(ServiceDescriptor, bCreated);
+	if (ServiceInstance == nullptr)
+	{
+		// Actor services which can only be found may still stream in with a level later on
+		if ((ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::FindOnly) && ServiceType->IsChildOf<AActor>())
+		{
+			AddPendingStreamedDescriptor(DescriptorIndex);
+		}
+		return;
+	}
+
+	AddService(ServiceDescriptor, DescriptorIndex, ServiceInstance, bCreated);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+AActor* UServiceLocatorContainer::GetTrackedActor(UObject* ServiceInstance) const
+{
+	if (AActor* ServiceAsActor = Cast<AActor>(ServiceInstance))
+	{
+		return ServiceAsActor;
+	}
+
+	// Components are tracked through their owner, unless it also owns this container, which shuts down with it
+	UActorComponent* ServiceAsComponent = Cast<UActorComponent>(ServiceInstance);
+	AActor* ComponentOwner = (ServiceAsComponent != nullptr) ? ServiceAsComponent->GetOwner() : nullptr;
+	return (ComponentOwner != GetTypedOuter<AActor>()) ? ComponentOwner : nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::AddService(const FServiceDescriptor& ServiceDescriptor, int32 DescriptorIndex, UObject* ServiceInstance, bool bCreated)
+{
+	Services.Emplace(ServiceInstance);
+	ServiceRecords.Emplace(DescriptorIndex, bCreated);
+
+	// Ticked services are gathered when the container next ticks
+	if (Cast<IServiceTickInterface>(ServiceInstance) != nullptr)
+	{
+		StartTicking();
+	}
+
+	// Actor and component services are tracked, so that they can be unmapped and recovered if destroyed
+	if (AActor* TrackedActor = GetTrackedActor(ServiceInstance))
+	{
+		TrackedActor->OnDestroyed.AddUniqueDynamic(this, &UServiceLocatorContainer::HandleActorServiceDestroyed);
+	}
+
+	// DestroyComponent() doesn't broadcast anything, so component services are also checked before each garbage collection
+	if ((Cast<UActorComponent>(ServiceInstance) != nullptr) && !PreGarbageCollectHandle.IsValid())
+	{
+		PreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &UServiceLocatorContainer::InvalidateDestroyedServices);
+	}
+
+	MapService(ServiceDescriptor, DescriptorIndex, ServiceInstance);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::MapService(const FServiceDescriptor& ServiceDescriptor, int32 DescriptorIndex, UObject* ServiceInstance)
+{
+	const FServiceDescriptorLayout* DescriptorLayout = GetDescriptorLayout(DescriptorIndex);
+	if (DescriptorLayout == nullptr)
+	{
+		return;
+	}
+
+	UClass* ServiceType = ServiceDescriptor.GetServiceType();
+	const FName ServiceKey = ServiceDescriptor.GetServiceKey();
+
+	// Mapped types were validated against the service type when the config's layout was built
+	for (const FServiceMappedTypeLayout& MappedTypeLayout : DescriptorLayout->MappedTypes)
+	{
+		UClass* MappedType = MappedTypeLayout.MappedType.Get();
+		if (MappedType == nullptr)
+		{
+			continue;
+		}
+
+		if (!ServiceKey.IsNone())
+		{
+			MapKeyedService(MappedType, ServiceKey, ServiceInstance);
+			continue;
+		}
+
+#if SERVICE_LOCATOR_OVERRIDES
+		// Overridden types keep their override, but will fall back to this service once the override is removed
+		if (FServiceOverride* ServiceOverride = ServiceOverrides.Find(MappedType))
+		{
+			ServiceOverride->UnderlyingInstance = ServiceInstance;
+			continue;
+		}
+#endif
+
+		UObject** ExistingMappedTypeService = MappedTypesToServices.Find(MappedType);
+		if (ExistingMappedTypeService != nullptr)
+		{
+			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateServices: Type '%s' is already mapped to Service '%s', but will be displaced by ServiceType '%s'"),
+				*GetNameSafe(MappedType), *GetNameSafe(*ExistingMappedTypeService), *GetNameSafe(ServiceType));
+		}
+
+		MappedTypesToServices.Emplace(MappedType, ServiceInstance);
+		++ServicesGeneration;
+
+#if SERVICE_LOCATOR_THREAD_CHECKS
+		if (ServiceDescriptor.ThreadAffinity == EServiceThreadAffinity::GameThreadOnly)
+		{
+			GameThreadOnlyMappedTypes.Emplace(MappedType);
+		}
+		else
+		{
+			GameThreadOnlyMappedTypes.Remove(MappedType);
+		}
+#endif
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::MapKeyedService(UClass* MappedType, FName ServiceKey, UObject* ServiceInstance)
+{
+	FKeyedServices& TypeKeyedServices = KeyedServices.FindOrAdd(MappedType);
+
+	const int32 KeyIndex = TypeKeyedServices.Keys.IndexOfByKey(ServiceKey);
+	if (KeyIndex != INDEX_NONE)
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::MapKeyedService: Type '%s' with key '%s' is already mapped to Service '%s', but will be displaced by Service '%s'"),
+			*GetNameSafe(MappedType), *ServiceKey.ToString(), *GetNameSafe(TypeKeyedServices.Instances[KeyIndex]), *GetNameSafe(ServiceInstance));
+
+		TypeKeyedServices.Instances[KeyIndex] = ServiceInstance;
+	}
+	else
+	{
+		TypeKeyedServices.Keys.Emplace(ServiceKey);
+		TypeKeyedServices.Instances.Emplace(ServiceInstance);
+	}
+
+	++ServicesGeneration;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::RegisterService(UClass* MappedType, UObject* ServiceInstance)
+{
+	if ((MappedType == nullptr) || (ServiceInstance == nullptr))
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::RegisterService: Unable to map service '%s' to type '%s' on container '%s'"),
+			*GetNameSafe(ServiceInstance), *GetNameSafe(MappedType), *GetNameSafe(this));
+		return;
+	}
+
+#if SERVICE_LOCATOR_OVERRIDES
+	if (FServiceOverride* ServiceOverride = ServiceOverrides.Find(MappedType))
+	{
+		ServiceOverride->UnderlyingInstance = ServiceInstance;
+		return;
+	}
+#endif
+
+	UObject** ExistingMappedTypeService = MappedTypesToServices.Find(MappedType);
+	if ((ExistingMappedTypeService != nullptr) && (*ExistingMappedTypeService != ServiceInstance))
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::RegisterService: Type '%s' is already mapped to Service '%s', but will be displaced by Service '%s'"),
+			*GetNameSafe(MappedType), *GetNameSafe(*ExistingMappedTypeService), *GetNameSafe(ServiceInstance));
+	}
+
+	MappedTypesToServices.Emplace(MappedType, ServiceInstance);
+	++ServicesGeneration;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::UnregisterService(UClass* MappedType, UObject* ServiceInstance)
+{
+#if SERVICE_LOCATOR_OVERRIDES
+	if (FServiceOverride* ServiceOverride = ServiceOverrides.Find(MappedType))
+	{
+		if (ServiceOverride->UnderlyingInstance == ServiceInstance)
+		{
+			ServiceOverride->UnderlyingInstance = nullptr;
+		}
+		return;
+	}
+#endif
+
+	UObject** ExistingMappedTypeService = MappedTypesToServices.Find(MappedType);
+	if ((ExistingMappedTypeService == nullptr) || (*ExistingMappedTypeService != ServiceInstance))
+	{
+		return;
+	}
+
+	MappedTypesToServices.Remove(MappedType);
+#if SERVICE_LOCATOR_THREAD_CHECKS
+	GameThreadOnlyMappedTypes.Remove(MappedType);
+#endif
+	++ServicesGeneration;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+#if SERVICE_LOCATOR_OVERRIDES
+
+void UServiceLocatorContainer::AddServiceOverride(UClass* OverriddenType, UObject* OverrideInstance)
+{
+	check(IsInGameThread());
+
+	if ((OverriddenType == nullptr) || (OverrideInstance == nullptr))
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::AddServiceOverride: Unable to override type '%s' with '%s' on container '%s'"),
+			*GetNameSafe(OverriddenType), *GetNameSafe(OverrideInstance), *GetNameSafe(this));
+		return;
+	}
+
+	const bool bIsCompatible = OverriddenType->HasAnyClassFlags(CLASS_Interface) ? OverrideInstance->GetClass()->ImplementsInterface(OverriddenType) : OverrideInstance->IsA(OverriddenType);
+	if (!bIsCompatible)
+	{
+		UE_LOG(LogUnrealServiceLocator, Error, TEXT("UServiceLocatorContainer::AddServiceOverride: Override '%s' isn't compatible with type '%s'"),
+			*GetNameSafe(OverrideInstance), *GetNameSafe(OverriddenType));
+		return;
+	}
+
+	FServiceOverride* ServiceOverride = ServiceOverrides.Find(OverriddenType);
+	if (ServiceOverride == nullptr)
+	{
+		ServiceOverride = &ServiceOverrides.Emplace(OverriddenType);
+
+		UObject** ExistingMappedTypeService = MappedTypesToServices.Find(OverriddenType);
+		ServiceOverride->UnderlyingInstance = (ExistingMappedTypeService != nullptr) ? *ExistingMappedTypeService : nullptr;
+	}
+
+	ServiceOverride->OverrideInstances.Emplace(OverrideInstance);
+
+	MappedTypesToServices.Emplace(OverriddenType, OverrideInstance);
+	++ServicesGeneration;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::RemoveServiceOverride(UClass* OverriddenType, UObject* OverrideInstance)
+{
+	check(IsInGameThread());
+
+	FServiceOverride* ServiceOverride = ServiceOverrides.Find(OverriddenType);
+	if ((ServiceOverride == nullptr) || (ServiceOverride->OverrideInstances.RemoveSingle(OverrideInstance) == 0))
+	{
+		return;
+	}
+
+	UObject* RestoredInstance = (ServiceOverride->OverrideInstances.Num() > 0) ? ServiceOverride->OverrideInstances.Last() : ServiceOverride->UnderlyingInstance;
+	if (RestoredInstance != nullptr)
+	{
+		MappedTypesToServices.Emplace(OverriddenType, RestoredInstance);
+	}
+	else
+	{
+		MappedTypesToServices.Remove(OverriddenType);
+	}
+
+	if (ServiceOverride->OverrideInstances.Num() == 0)
+	{
+		ServiceOverrides.Remove(OverriddenType);
+	}
+
+	++ServicesGeneration;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::RemoveAllServiceOverrides()
+{
+	check(IsInGameThread());
+
+	for (const TPair<UClass*, FServiceOverride>& ServiceOverride : ServiceOverrides)
+	{
+		if (ServiceOverride.Value.UnderlyingInstance != nullptr)
+		{
+			MappedTypesToServices.Emplace(ServiceOverride.Key, ServiceOverride.Value.UnderlyingInstance);
+		}
+		else
+		{
+			MappedTypesToServices.Remove(ServiceOverride.Key);
+		}
+	}
+
+	ServiceOverrides.Reset();
+	++ServicesGeneration;
+}
+
+#endif // SERVICE_LOCATOR_OVERRIDES
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	UServiceLocatorContainer* This = CastChecked<UServiceLocatorContainer>(InThis);
+	for (TPair<UClass*, FKeyedServices>& TypeKeyedServices : This->KeyedServices)
+	{
+		Collector.AddReferencedObjects(TypeKeyedServices.Value.Instances, This);
+	}
+
+	// Services still warming up must stay alive even once destroyed, as their tasks are using them
+	Collector.AllowEliminatingReferences(false);
+	for (FWarmUpTask& WarmUpTask : This->WarmUpTasks)
+	{
+		Collector.AddReferencedObject(WarmUpTask.ServiceInstance, This);
+	}
+	Collector.AllowEliminatingReferences(true);
+
+#if SERVICE_LOCATOR_OVERRIDES
+	// Overrides are mapped, so they're already referenced, but the services they displaced may not be
+	for (TPair<UClass*, FServiceOverride>& ServiceOverride : This->ServiceOverrides)
+	{
+		Collector.AddReferencedObject(ServiceOverride.Value.UnderlyingInstance, This);
+		Collector.AddReferencedObjects(ServiceOverride.Value.OverrideInstances, This);
+	}
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		// Objects may resolve to this container from now on, rather than to the one they resolved to before
+		FServiceLocatorContainerRegistry::InvalidateResolvedContainers();
+
+		// Calls and events may be queued from any thread, so start ticking whenever the first one arrives
+		QueuedServiceCalls->SetOnFirstCallQueued(MakeStartTickingFunction());
+		EventBus.SetOnFirstEventPublished(MakeStartTickingFunction());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::BeginDestroy()
+{
+	Ticker.Reset();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		FServiceLocatorContainerRegistry::InvalidateResolvedContainers();
+	}
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+	PreGarbageCollectHandle.Reset();
+
+	// A container may be destroyed without its services being shut down, which mustn't leave the streaming handlers bound
+	StopWaitingForStreamedServices();
+
+	// Warm-up tasks rely on the container to keep their services alive, so they can't be allowed to outlive it
+	WaitForWarmUp();
+
+	Super::BeginDestroy();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::TickAsyncLocate()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_TickAsyncLocate);
+
+	if (ActiveConfig == nullptr)
+	{
+		FinishLocatingServices();
+		return;
+	}
+
+	const TArray<FServiceDescriptor>& ServiceDescriptors = ActiveConfig->ServiceDescriptors;
+	const double EndTime = FPlatformTime::Seconds() + (AsyncLocateBudgetMs / 1000.0);
+
+	TGuardValue<bool> DeferActorServiceSpawning(bDeferActorServiceSpawning, true);
+
+	// Always process at least one descriptor per frame, so that a tiny budget can't stall location entirely
+	while (ServiceDescriptors.IsValidIndex(AsyncDescriptorIndex))
+	{
+		const int32 DescriptorIndex = AsyncDescriptorIndex++;
+
+		const FServiceDescriptor& ServiceDescriptor = ServiceDescriptors[DescriptorIndex];
+		if (ServiceDescriptor.bCritical || !IsDescriptorActive(DescriptorIndex))
+		{
+			continue;
+		}
+
+		LocateAndCreateService(ServiceDescriptor, DescriptorIndex);
+
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+
+	// Actor services located this frame finish spawning together, so each frame's slice is a batch of its own
+	FinishSpawningActorServices();
+
+	if (!ServiceDescriptors.IsValidIndex(AsyncDescriptorIndex))
+	{
+		FinishLocatingServices();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::FinishLocatingServices()
+{
+	AsyncDescriptorIndex = INDEX_NONE;
+	PendingMappedTypes.Empty();
+
+	// Services are only injected now, so that every service they depend on has been located, regardless of descriptor order
+	for (UObject* ServiceInstance : Services)
+	{
+		if (IsValid(ServiceInstance))
+		{
+			InjectServicesInternal(ServiceInstance);
+		}
+	}
+
+	for (const TWeakObjectPtr<UObject>& PendingInjectionTarget : PendingInjectionTargets)
+	{
+		if (UObject* InjectionTarget = PendingInjectionTarget.Get())
+		{
+			InjectServicesInternal(InjectionTarget);
+		}
+	}
+
+	PendingInjectionTargets.Reset();
+
+	OnServicesLocated.Broadcast(this);
+
+	StartWarmingUpServices();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::StartWarmingUpServices()
+{
+	for (UObject* ServiceInstance : Services)
+	{
+		if (!IsValid(ServiceInstance) || WarmedServices.Contains(ServiceInstance))
+		{
+			continue;
+		}
+
+		IServiceWarmUpInterface* WarmUpInterface = Cast<IServiceWarmUpInterface>(ServiceInstance);
+		if (WarmUpInterface == nullptr)
+		{
+			continue;
+		}
+
+		// Services are only ever warmed up once, even if they're located again
+		WarmedServices.Emplace(ServiceInstance);
+
+		FWarmUpTask& WarmUpTask = WarmUpTasks.AddDefaulted_GetRef();
+		WarmUpTask.ServiceInstance = ServiceInstance;
+		WarmUpTask.Task = FFunctionGraphTask::CreateAndDispatchWhenReady([WarmUpInterface]()
+		{
+			WarmUpInterface->WarmUpService();
+		}, GET_STATID(STAT_UServiceLocatorContainer_WarmUpService), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
+	}
+
+	bServicesWarm = false;
+
+	if (WarmUpTasks.Num() > 0)
+	{
+		StartTicking();
+	}
+
+	// If nothing needs to warm up, the services are warm straight away
+	FinishWarmingUpServices();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::FinishWarmingUpServices()
+{
+	if (bServicesWarm)
+	{
+		return;
+	}
+
+	for (const FWarmUpTask& WarmUpTask : WarmUpTasks)
+	{
+		if (!WarmUpTask.Task->IsComplete())
+		{
+			return;
+		}
+	}
+
+	WarmUpTasks.Reset();
+	bServicesWarm = true;
+
+	OnServicesWarm.Broadcast(this);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::WaitForWarmUp()
+{
+	for (const FWarmUpTask& WarmUpTask : WarmUpTasks)
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(WarmUpTask.Task, ENamedThreads::GameThread);
+	}
+
+	WarmUpTasks.Reset();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::WaitForServiceWarmUp(UObject* ServiceInstance)
+{
+	// The task stays in WarmUpTasks, so that progress and completion are still reported for it
+	const FWarmUpTask* WarmUpTask = WarmUpTasks.FindByPredicate([ServiceInstance](const FWarmUpTask& Candidate) { return Candidate.ServiceInstance == ServiceInstance; });
+	if (WarmUpTask != nullptr)
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(WarmUpTask->Task, ENamedThreads::GameThread);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+float UServiceLocatorContainer::GetWarmUpProgress() const
+{
+	if (WarmUpTasks.Num() > 0)
+	{
+		int32 NumCompleted = 0;
+		for (const FWarmUpTask& WarmUpTask : WarmUpTasks)
+		{
+			NumCompleted += WarmUpTask.Task->IsComplete() ? 1 : 0;
+		}
+
+		return float(NumCompleted) / float(WarmUpTasks.Num());
+	}
+
+	return AreServicesWarm() ? 1.0f : 0.0f;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+int32 UServiceLocatorContainer::InjectServices(UObject* Object)
+{
+	if (Object == nullptr)
+	{
+		return 0;
+	}
+
+	if (IsLocatingServices() || IsLoadingServiceClasses())
+	{
+		PendingInjectionTargets.AddUnique(Object);
+	}
+
+	// Targets are kept, so that a recovered service can replace the destroyed one they hold
+	InjectionTargets.Emplace(Object);
+	if (InjectionTargets.Num() > FMath::Max(2 * NumInjectionTargetsAfterCompaction, 64))
+	{
+		for (TSet<TWeakObjectPtr<UObject>>::TIterator Iter = InjectionTargets.CreateIterator(); Iter; ++Iter)
+		{
+			if (!Iter->IsValid())
+			{
+				Iter.RemoveCurrent();
+			}
+		}
+
+		NumInjectionTargetsAfterCompaction = InjectionTargets.Num();
+	}
+
+	return InjectServicesInternal(Object);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+int32 UServiceLocatorContainer::InjectServicesInternal(UObject* Object)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_InjectServices);
+
+	const FServiceInjectionPoints& InjectionPoints = FServiceLocatorInjection::GetInjectionPoints(Object->GetClass());
+	uint8* ObjectAddress = reinterpret_cast<uint8*>(Object);
+	int32 NumInjected = 0;
+
+	for (const FServiceInjectionPoint& InjectionPoint : InjectionPoints)
+	{
+		// Pure finds, so that injecting never locates or creates services as a side effect
+		UObject* ServiceInstance = InjectionPoint.ServiceKey.IsNone()
+			? GetServiceInternal(InjectionPoint.ServiceType)
+			: GetKeyedServiceInternal(InjectionPoint.ServiceType, InjectionPoint.ServiceKey);
+
+		if (ServiceInstance == nullptr)
+		{
+			continue;
+		}
+
+		if (InjectionPoint.bInterface)
+		{
+			FScriptInterface& Interface = *reinterpret_cast<FScriptInterface*>(ObjectAddress + InjectionPoint.Offset);
+			Interface.SetObject(ServiceInstance);
+			Interface.SetInterface(ServiceInstance->GetInterfaceAddress(InjectionPoint.ServiceType));
+		}
+		else
+		{
+			*reinterpret_cast<UObject**>(ObjectAddress + InjectionPoint.Offset) = ServiceInstance;
+		}
+
+		++NumInjected;
+	}
+
+	return NumInjected;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorContainer_Private
+{
+
+	// Bumped whenever the snapshot layout changes, so that old snapshots are rejected rather than misread
+	const int32 ServicesSnapshotVersion = 1;
+
+	bool HasSaveGameProperties(const UClass* ServiceClass)
+	{
+		for (TFieldIterator<FProperty> PropertyIt(ServiceClass); PropertyIt; ++PropertyIt)
+		{
+			if (PropertyIt->HasAnyPropertyFlags(CPF_SaveGame))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void SerializeSaveGameProperties(UObject* ServiceInstance, FArchive& InnerArchive)
+	{
+		FObjectAndNameAsStringProxyArchive Archive(InnerArchive, true);
+		Archive.ArIsSaveGame = true;
+		ServiceInstance->Serialize(Archive);
+	}
+
+} // namespace ServiceLocatorContainer_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+bool UServiceLocatorContainer::SaveServicesSnapshot(TArray<uint8>& OutSnapshot) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_SaveServicesSnapshot);
+	check(IsInGameThread());
+
+	if ((ActiveConfig == nullptr) || IsLocatingServices())
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::SaveServicesSnapshot: Container '%s' with outer '%s' has no config or is still locating services"),
+			*GetNameSafe(this), *GetNameSafe(GetOuter()));
+		return false;
+	}
+
+	OutSnapshot.Reset();
+	FMemoryWriter Writer(OutSnapshot);
+
+	int32 Version = ServiceLocatorContainer_Private::ServicesSnapshotVersion;
+	// Merged configs are transient, so snapshots are matched against the config asset, and the descriptor count catches native changes
+	FString ConfigPath = GetPathNameSafe(Config);
+	int32 NumDescriptors = ActiveConfig->ServiceDescriptors.Num();
+	Writer << Version << ConfigPath << NumDescriptors;
+
+	// The record count is patched in afterwards, as some services may be left out
+	const int64 NumRecordsOffset = Writer.Tell();
+	int32 NumRecords = 0;
+	Writer << NumRecords;
+
+	TArray<uint8> Payload;
+	for (int32 ServiceIndex = 0; ServiceIndex < Services.Num(); ++ServiceIndex)
+	{
+		UObject* ServiceInstance = Services[ServiceIndex];
+		FServiceRecord ServiceRecord = ServiceRecords[ServiceIndex];
+
+		// Services which have been destroyed and not yet recovered are left out, and will be located as normal on restore
+		if (!IsValid(ServiceInstance) || !ActiveConfig->ServiceDescriptors.IsValidIndex(ServiceRecord.DescriptorIndex))
+		{
+			continue;
+		}
+
+		FName ServiceTypeName = ActiveConfig->ServiceDescriptors[ServiceRecord.DescriptorIndex].GetServiceType()->GetFName();
+
+		// Located services are recorded relative to where they were found, so that the path survives PIE package renaming
+		FString ServicePath = ServiceRecord.bCreated ? FString() : ServiceInstance->GetPathName(GetServiceSearchRoot(ServiceInstance->GetClass()));
+
+		Payload.Reset();
+		if (ServiceLocatorContainer_Private::HasSaveGameProperties(ServiceInstance->GetClass()))
+		{
+			FMemoryWriter PayloadWriter(Payload);
+			ServiceLocatorContainer_Private::SerializeSaveGameProperties(ServiceInstance, PayloadWriter);
+		}
+
+		Writer << ServiceRecord.DescriptorIndex << ServiceRecord.bCreated << ServiceTypeName << ServicePath << Payload;
+		++NumRecords;
+	}
+
+	const int64 EndOffset = Writer.Tell();
+	Writer.Seek(NumRecordsOffset);
+	Writer << NumRecords;
+	Writer.Seek(EndOffset);
+
+	return !Writer.IsError();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+bool UServiceLocatorContainer::RestoreServicesFromSnapshot(const TArray<uint8>& Snapshot)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_RestoreServicesFromSnapshot);
+	check(IsInGameThread());
+
+	if (!IsLocatingServices() && (Services.Num() == 0))
+	{
+		ResolveActiveConfig();
+	}
+
+	if ((ActiveConfig == nullptr) || IsLocatingServices() || (Services.Num() > 0))
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::RestoreServicesFromSnapshot: Container '%s' with outer '%s' has no config, or has already located services"),
+			*GetNameSafe(this), *GetNameSafe(GetOuter()));
+		return false;
+	}
+
+	EvaluateDescriptorConditions();
+	LoadServiceClassesSynchronous();
+
+	FMemoryReader Reader(Snapshot);
+
+	int32 Version = 0;
+	FString ConfigPath;
+	int32 NumDescriptors = 0;
+	int32 NumRecords = 0;
+	Reader << Version << ConfigPath << NumDescriptors << NumRecords;
+
+	const TArray<FServiceDescriptor>& ServiceDescriptors = ActiveConfig->ServiceDescriptors;
+	if (Reader.IsError() || (Version != ServiceLocatorContainer_Private::ServicesSnapshotVersion) || (ConfigPath != GetPathNameSafe(Config)) || (NumDescriptors != ServiceDescriptors.Num()))
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::RestoreServicesFromSnapshot: Snapshot doesn't match config '%s' on container '%s'"),
+			*GetNameSafe(ActiveConfig), *GetNameSafe(this));
+		return false;
+	}
+
+	TBitArray<> RestoredDescriptors(false, ServiceDescriptors.Num());
+
+	// Deferring construction also means restored properties are in place before the actor services are initialised
+	TGuardValue<bool> DeferActorServiceSpawning(bDeferActorServiceSpawning, true);
+
+	TArray<uint8> Payload;
+	for (int32 RecordIndex = 0; RecordIndex < NumRecords; ++RecordIndex)
+	{
+		int32 DescriptorIndex = INDEX_NONE;
+		bool bCreated = false;
+		FName ServiceTypeName;
+		FString ServicePath;
+		Reader << DescriptorIndex << bCreated << ServiceTypeName << ServicePath << Payload;
+
+		if (Reader.IsError() || !ServiceDescriptors.IsValidIndex(DescriptorIndex))
+		{
+			UE_LOG(LogUnrealServiceLocator, Error, TEXT("UServiceLocatorContainer::RestoreServicesFromSnapshot: Snapshot for config '%s' is corrupt, locating the remaining services as normal"),
+				*GetNameSafe(ActiveConfig));
+			break;
+		}
+
+		const FServiceDescriptor& ServiceDescriptor = ServiceDescriptors[DescriptorIndex];
+		UClass* ServiceType = ServiceDescriptor.GetServiceType();
+		RestoredDescriptors[DescriptorIndex] = true;
+
+		// The config may have been edited since the snapshot was taken
+		if ((ServiceType == nullptr) || (ServiceType->GetFName() != ServiceTypeName) || !IsDescriptorActive(DescriptorIndex))
+		{
+			LocateAndCreateService(ServiceDescriptor, DescriptorIndex);
+			continue;
+		}
+
+		UObject* ServiceInstance = nullptr;
+		if (bCreated)
+		{
+			// The service had to be created last time, so there's no point searching for it
+			bool bRecreated = false;
+			ServiceInstance = LocateOrCreateService(ServiceDescriptor, bRecreated, true /* bSkipLocate */);
+		}
+		else
+		{
+			ServiceInstance = StaticFindObject(ServiceType, GetServiceSearchRoot(ServiceType), *ServicePath);
+			if (!IsValid(ServiceInstance))
+			{
+				UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::RestoreServicesFromSnapshot: Unable to resolve service '%s' of type '%s', locating it as normal"),
+					*ServicePath, *GetNameSafe(ServiceType));
+
+				LocateAndCreateService(ServiceDescriptor, DescriptorIndex);
+				continue;
+			}
+		}
+
+		if (ServiceInstance == nullptr)
+		{
+			continue;
+		}
+
+		if (Payload.Num() > 0)
+		{
+			FMemoryReader PayloadReader(Payload);
+			ServiceLocatorContainer_Private::SerializeSaveGameProperties(ServiceInstance, PayloadReader);
+		}
+
+		AddService(ServiceDescriptor, DescriptorIndex, ServiceInstance, bCreated);
+	}
+
+	// Actor services which couldn't be found when the snapshot was taken may still stream in
+	for (int32 DescriptorIndex = 0; DescriptorIndex < ServiceDescriptors.Num(); ++DescriptorIndex)
+	{
+		const FServiceDescriptor& ServiceDescriptor = ServiceDescriptors[DescriptorIndex];
+		if (!RestoredDescriptors[DescriptorIndex] && (ServiceDescriptor.GetServiceType() != nullptr) && ServiceDescriptor.GetServiceType()->IsChildOf<AActor>()
+			&& (ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::FindOnly) && IsDescriptorActive(DescriptorIndex))
+		{
+			AddPendingStreamedDescriptor(DescriptorIndex);
+		}
+	}
+
+	FinishSpawningActorServices();
+	FinishLocatingServices();
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::AddPendingStreamedDescriptor(int32 DescriptorIndex)
+{
+	UWorld* LocalWorld = GetWorld();
+	if (LocalWorld == nullptr)
+	{
+		return;
+	}
+
+	PendingStreamedDescriptorIndices.AddUnique(DescriptorIndex);
+
+	// Only actors in newly added levels and newly spawned actors are checked, rather than rescanning the whole world
+	if (!LevelAddedToWorldHandle.IsValid())
+	{
+		LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UServiceLocatorContainer::HandleLevelAddedToWorld);
+	}
+
+	if (!ActorSpawnedHandle.IsValid())
+	{
+		ActorSpawnedHandle = LocalWorld->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UServiceLocatorContainer::HandleActorSpawned));
+		ActorSpawnedWorld = LocalWorld;
+
+		// The container's actor may leave play without shutting its services down, which mustn't leave the handlers bound
+		if (AActor* OuterActor = GetTypedOuter<AActor>())
+		{
+			OuterActor->OnEndPlay.AddUniqueDynamic(this, &UServiceLocatorContainer::HandleOuterActorEndPlay);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::StopWaitingForStreamedServices()
+{
+	PendingStreamedDescriptorIndices.Reset();
+
+	if (LevelAddedToWorldHandle.IsValid())
+	{
+		FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+		LevelAddedToWorldHandle.Reset();
+	}
+
+	if (ActorSpawnedHandle.IsValid())
+	{
+		if (UWorld* LocalWorld = ActorSpawnedWorld.Get())
+		{
+			LocalWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		}
+
+		ActorSpawnedHandle.Reset();
+		ActorSpawnedWorld.Reset();
+
+		if (AActor* OuterActor = GetTypedOuter<AActor>())
+		{
+			OuterActor->OnEndPlay.RemoveDynamic(this, &UServiceLocatorContainer::HandleOuterActorEndPlay);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::HandleOuterActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	StopWaitingForStreamedServices();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_HandleLevelAddedToWorld);
+
+	if ((Level == nullptr) || (World != GetWorld()))
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (PendingStreamedDescriptorIndices.Num() == 0)
+		{
+			break;
+		}
+
+		MapStreamedActor(Actor);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::HandleActorSpawned(AActor* Actor)
+{
+	MapStreamedActor(Actor);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::MapStreamedActor(AActor* Actor)
+{
+	if (!IsValid(Actor) || (ActiveConfig == nullptr))
+	{
+		return;
+	}
+
+	const TArray<FServiceDescriptor>& ServiceDescriptors = ActiveConfig->ServiceDescriptors;
+
+	for (int32 PendingIndex = 0; PendingIndex < PendingStreamedDescriptorIndices.Num(); ++PendingIndex)
+	{
+		const int32 DescriptorIndex = PendingStreamedDescriptorIndices[PendingIndex];
+		if (!ServiceDescriptors.IsValidIndex(DescriptorIndex))
+		{
+			continue;
+		}
+
+		const FServiceDescriptor& ServiceDescriptor = ServiceDescriptors[DescriptorIndex];
+		UClass* ServiceType = ServiceDescriptor.GetServiceType();
+		if ((ServiceType == nullptr) || !Actor->IsA(ServiceType))
+		{
+			continue;
+		}
+
+		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::MapStreamedActor: Found streamed in actor service '%s' of type '%s'"),
+			*GetNameSafe(Actor), *GetNameSafe(ServiceDescriptor.GetServiceType()));
+
+		PendingStreamedDescriptorIndices.RemoveAt(PendingIndex);
+		AddService(ServiceDescriptor, DescriptorIndex, Actor, false);
+		break;
+	}
+
+	if (PendingStreamedDescriptorIndices.Num() == 0)
+	{
+		StopWaitingForStreamedServices();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+const FServiceDescriptorLayout* UServiceLocatorContainer::GetDescriptorLayout(int32 DescriptorIndex)
+{
+	if (ActiveConfig == nullptr)
+	{
+		return nullptr;
+	}
+
+	// The layout is shared with every other container using the same config, across every world in the process
+	if (!ConfigLayout.IsValid() || (ConfigLayout->Descriptors.Num() != ActiveConfig->ServiceDescriptors.Num()))
+	{
+		ConfigLayout = FServiceLocatorClassCache::GetConfigLayout(ActiveConfig);
+	}
+	else if ((ConfigLayout->NumUnresolvedClasses > 0) && ConfigLayout->Descriptors.IsValidIndex(DescriptorIndex)
+		&& !ConfigLayout->Descriptors[DescriptorIndex].bValidServiceType && ActiveConfig->ServiceDescriptors[DescriptorIndex].ServiceType.IsValid())
+	{
+		// The service class wasn't loaded when the layout was built, but has been loaded since
+		ConfigLayout = FServiceLocatorClassCache::GetConfigLayout(ActiveConfig);
+	}
+
+	return ConfigLayout->Descriptors.IsValidIndex(DescriptorIndex) ? &ConfigLayout->Descriptors[DescriptorIndex] : nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+UObject* UServiceLocatorContainer::GetServiceSearchRoot(const UClass* ServiceType) const
+{
+	if (ServiceType->IsChildOf<AActor>())
+	{
+		return GetWorld();
+	}
+
+	if (ServiceType->IsChildOf<UActorComponent>())
+	{
+		return GetTypedOuter<AActor>();
+	}
+
+	return GetOuter();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorContainer_Private
+{
+
+	using FServiceDependencies = TArray<int32, TInlineAllocator<4>>;
+
+	// Finds the services injected into each service, read back from its injected properties, as indices into Services
+	void FindServiceDependencies(const TArray<UObject*>& Services, TArray<FServiceDependencies>& OutDependencies)
+	{
+		TMap<const UObject*, int32> ServiceIndices;
+		ServiceIndices.Reserve(Services.Num());
+		for (int32 ServiceIndex = 0; ServiceIndex < Services.Num(); ++ServiceIndex)
+		{
+			ServiceIndices.Add(Services[ServiceIndex], ServiceIndex);
+		}
+
+		OutDependencies.Reset(Services.Num());
+		OutDependencies.AddDefaulted(Services.Num());
+
+		for (int32 ServiceIndex = 0; ServiceIndex < Services.Num(); ++ServiceIndex)
+		{
+			const UObject* ServiceInstance = Services[ServiceIndex];
+			if (!IsValid(ServiceInstance))
+				continue;
+
+			const uint8* ObjectAddress = reinterpret_cast<const uint8*>(ServiceInstance);
+			for (const FServiceInjectionPoint& InjectionPoint : FServiceLocatorInjection::GetInjectionPoints(ServiceInstance->GetClass()))
+			{
+				const UObject* InjectedService = InjectionPoint.bInterface
+					? reinterpret_cast<const FScriptInterface*>(ObjectAddress + InjectionPoint.Offset)->GetObject()
+					: *reinterpret_cast<UObject* const*>(ObjectAddress + InjectionPoint.Offset);
+
+				const int32* DependencyIndex = (InjectedService != nullptr) ? ServiceIndices.Find(InjectedService) : nullptr;
+				if ((DependencyIndex != nullptr) && (*DependencyIndex != ServiceIndex))
+				{
+					OutDependencies[ServiceIndex].AddUnique(*DependencyIndex);
+				}
+			}
+		}
+	}
+
+	// Orders services so that each is shut down before the services injected into it. Services which don't depend on each other,
+	// or which depend on each other in a cycle, keep reverse creation order.
+	void GetShutdownOrder(const TArray<FServiceDependencies>& Dependencies, TArray<int32>& OutShutdownOrder)
+	{
+		OutShutdownOrder.Reset(Dependencies.Num());
+
+		// Dependencies are visited before the services injected with them, so reversing the visit order puts dependents first
+		TBitArray<> Visited(false, Dependencies.Num());
+		TArray<TPair<int32, int32>, TInlineAllocator<16>> Stack;
+
+		for (int32 RootIndex = 0; RootIndex < Dependencies.Num(); ++RootIndex)
+		{
+			if (Visited[RootIndex])
+				continue;
+
+			Visited[RootIndex] = true;
+			Stack.Emplace(RootIndex, 0);
+
+			while (Stack.Num() > 0)
+			{
+				TPair<int32, int32>& Top = Stack.Last();
+				const FServiceDependencies& TopDependencies = Dependencies[Top.Key];
+
+				if (Top.Value < TopDependencies.Num())
+				{
+					const int32 DependencyIndex = TopDependencies[Top.Value++];
+					if (!Visited[DependencyIndex])
+					{
+						Visited[DependencyIndex] = true;
+						Stack.Emplace(DependencyIndex, 0);
+					}
+					continue;
+				}
+
+				OutShutdownOrder.Add(Top.Key);
+				Stack.Pop(false);
+			}
+		}
+
+		Algo::Reverse(OutShutdownOrder);
+	}
+
+} // namespace ServiceLocatorContainer_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::ShutdownServices(TArray<FServiceShutdownTiming>* OutTimings)
+{
+	using namespace ServiceLocatorContainer_Private;
+
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_ShutdownServices);
+	check(IsInGameThread());
+
+	// Anything queued against the services should run while they're still alive
+	FlushQueuedServiceCalls();
+	DispatchServiceEvents();
+	EventBus.Reset();
+
+	AsyncDescriptorIndex = INDEX_NONE;
+	PendingMappedTypes.Empty();
+	PendingRecoveryDescriptorIndices.Reset();
+	LazyRecoveryTypes.Reset();
+	StopWaitingForStreamedServices();
+	FServiceLocatorWorldRegistry::UnregisterRootContainer(GetWorld(), this);
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+	PreGarbageCollectHandle.Reset();
+
+	if (ServiceClassesHandle.IsValid())
+	{
+		ServiceClassesHandle->CancelHandle();
+		ServiceClassesHandle.Reset();
+	}
+
+	// Services can't be shut down while they're still warming up on another thread
+	WaitForWarmUp();
+	WarmedServices.Reset();
+	bServicesWarm = false;
+
+	for (UObject* ServiceInstance : Services)
+	{
+		if (AActor* TrackedActor = GetTrackedActor(ServiceInstance))
+		{
+			TrackedActor->OnDestroyed.RemoveDynamic(this, &UServiceLocatorContainer::HandleActorServiceDestroyed);
+		}
+	}
+
+	// Every mapping is cleared before any service is touched, so that nothing can retrieve a half shut down service
+	TArray<UObject*> ServicesToShutdown = MoveTemp(Services);
+
+	TArray<FServiceDependencies> Dependencies;
+	FindServiceDependencies(ServicesToShutdown, Dependencies);
+
+	TArray<int32> ShutdownOrder;
+	GetShutdownOrder(Dependencies, ShutdownOrder);
+
+	TArray<FServiceRecord> RecordsToShutdown = MoveTemp(ServiceRecords);
+	MappedTypesToServices.Reset();
+	KeyedServices.Reset();
+	PendingInjectionTargets.Reset();
+	InjectionTargets.Reset();
+	NumInjectionTargetsAfterCompaction = 0;
+	DeferredActorServices.Reset();
+#if SERVICE_LOCATOR_THREAD_CHECKS
+	GameThreadOnlyMappedTypes.Reset();
+#endif
+#if SERVICE_LOCATOR_OVERRIDES
+	ServiceOverrides.Reset();
+#endif
+	++ServicesGeneration;
+
+	const TArray<FServiceDescriptor>* ServiceDescriptors = (ActiveConfig != nullptr) ? &ActiveConfig->ServiceDescriptors : nullptr;
+
+	TArray<FServiceShutdownTiming> Timings;
+	Timings.Reserve(ServicesToShutdown.Num());
+
+	// Object services can only be shut down in parallel if their descriptor says they're safe to use from any thread,
+	// and nothing about them (unlike actors and components) requires destruction on the game thread
+	auto CanShutdownInParallel = [&](int32 ServiceIndex) -> bool
+	{
+		UObject* ServiceInstance = ServicesToShutdown[ServiceIndex];
+		const FServiceRecord& ServiceRecord = RecordsToShutdown[ServiceIndex];
+
+		if (!ServiceRecord.bCreated || !IsValid(ServiceInstance))
+			return false;
+
+		if (ServiceInstance->IsA<AActor>() || ServiceInstance->IsA<UActorComponent>())
+			return false;
+
+		if (!ServiceInstance->GetClass()->ImplementsInterface(UServiceShutdownInterface::StaticClass()))
+			return false;
+
+		return (ServiceDescriptors != nullptr)
+			&& ServiceDescriptors->IsValidIndex(ServiceRecord.DescriptorIndex)
+			&& ((*ServiceDescriptors)[ServiceRecord.DescriptorIndex].ThreadAffinity == EServiceThreadAffinity::AnyThread);
+	};
+
+	TArray<int32, TInlineAllocator<16>> ParallelBatch;
+
+	// The services injected into the batch, which mustn't be shut down alongside it
+	TBitArray<> ParallelBatchDependencies(false, ServicesToShutdown.Num());
+
+	auto ShutdownParallelBatch = [&]()
+	{
+		if (ParallelBatch.Num() == 0)
+			return;
+
+		ParallelBatchDependencies.Init(false, ServicesToShutdown.Num());
+
+		const int32 FirstTimingIndex = Timings.AddDefaulted(ParallelBatch.Num());
+
+		ParallelFor(ParallelBatch.Num(), [&](int32 BatchIndex)
+		{
+			UObject* ServiceInstance = ServicesToShutdown[ParallelBatch[BatchIndex]];
+
+			const double StartTime = FPlatformTime::Seconds();
+			Cast<IServiceShutdownInterface>(ServiceInstance)->ShutdownService();
+
+			FServiceShutdownTiming& Timing = Timings[FirstTimingIndex + BatchIndex];
+			Timing.Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			Timing.bParallel = true;
+		});
+
+		// Destruction itself still has to happen on the game thread
+		for (int32 BatchIndex = 0; BatchIndex < ParallelBatch.Num(); ++BatchIndex)
+		{
+			const int32 ServiceIndex = ParallelBatch[BatchIndex];
+			UObject* ServiceInstance = ServicesToShutdown[ServiceIndex];
+
+			const double StartTime = FPlatformTime::Seconds();
+			DestroyService(ServiceInstance, RecordsToShutdown[ServiceIndex].DescriptorIndex);
+
+			FServiceShutdownTiming& Timing = Timings[FirstTimingIndex + BatchIndex];
+			Timing.ServiceName = ServiceInstance->GetFName();
+			Timing.ServiceType = ServiceInstance->GetClass();
+			Timing.Milliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		}
+
+		ParallelBatch.Reset();
+	};
+
+	// Services are shut down before the services injected into them, and otherwise in reverse creation order
+	for (const int32 ServiceIndex : ShutdownOrder)
+	{
+		if (CanShutdownInParallel(ServiceIndex))
+		{
+			if (ParallelBatchDependencies[ServiceIndex])
+			{
+				ShutdownParallelBatch();
+			}
+
+			ParallelBatch.Add(ServiceIndex);
+			for (const int32 DependencyIndex : Dependencies[ServiceIndex])
+			{
+				ParallelBatchDependencies[DependencyIndex] = true;
+			}
+			continue;
+		}
+
+		// Anything that can't be shut down in parallel acts as a barrier, preserving the order relative to it
+		ShutdownParallelBatch();
+
+		UObject* ServiceInstance = ServicesToShutdown[ServiceIndex];
+		if (!RecordsToShutdown[ServiceIndex].bCreated || !IsValid(ServiceInstance))
+		{
+			continue;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		IServiceShutdownInterface* ServiceAsShutdownInterface = Cast<IServiceShutdownInterface>(ServiceInstance);
+		if (ServiceAsShutdownInterface != nullptr)
+		{
+			ServiceAsShutdownInterface->ShutdownService();
+		}
+
+		DestroyService(ServiceInstance, RecordsToShutdown[ServiceIndex].DescriptorIndex);
+
+		FServiceShutdownTiming& Timing = Timings.AddDefaulted_GetRef();
+		Timing.ServiceName = ServiceInstance->GetFName();
+		Timing.ServiceType = ServiceInstance->GetClass();
+		Timing.Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+
+	ShutdownParallelBatch();
+
+	double TotalMilliseconds = 0.0;
+	for (const FServiceShutdownTiming& Timing : Timings)
+	{
+		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::ShutdownServices: Shut down service '%s' of type '%s' in %.3fms%s"),
+			*Timing.ServiceName.ToString(), *GetNameSafe(Timing.ServiceType), Timing.Milliseconds, Timing.bParallel ? TEXT(" (parallel)") : TEXT(""));
+
+		TotalMilliseconds += Timing.Milliseconds;
+	}
+
+	UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::ShutdownServices: Shut down %d services for container '%s' with outer '%s' in %.3fms"),
+		Timings.Num(), *GetNameSafe(this), *GetNameSafe(GetOuter()), TotalMilliseconds);
+
+	if (OutTimings != nullptr)
+	{
+		*OutTimings = MoveTemp(Timings);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::DestroyService(UObject* ServiceInstance, int32 DescriptorIndex)
+{
+	// Services created by a factory are handed back to it, so that it can recycle them
+	UServiceFactory* Factory = ((ActiveConfig != nullptr) && ActiveConfig->ServiceDescriptors.IsValidIndex(DescriptorIndex)) ? ActiveConfig->ServiceDescriptors[DescriptorIndex].Factory : nullptr;
+	if ((Factory != nullptr) && Factory->DestroyService(this, ServiceInstance))
+	{
+		return;
+	}
+
+	if (AActor* ServiceAsActor = Cast<AActor>(ServiceInstance))
+	{
+		ServiceAsActor->Destroy();
+		return;
+	}
+
+	if (UActorComponent* ServiceAsComponent = Cast<UActorComponent>(ServiceInstance))
+	{
+		ServiceAsComponent->DestroyComponent();
+		return;
+	}
+
+	ServiceInstance->MarkPendingKill();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::HandleActorServiceDestroyed(AActor* DestroyedActor)
+{
+	// Either the actor is a service itself, or it owns component services
+	for (int32 ServiceIndex = Services.Num() - 1; ServiceIndex >= 0; --ServiceIndex)
+	{
+		if (GetTrackedActor(Services[ServiceIndex]) == DestroyedActor)
+		{
+			InvalidateService(ServiceIndex);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::InvalidateDestroyedServices()
+{
+	// Catches services destroyed without their tracked actor being destroyed, e.g. a component destroyed on its own.
+	// The entry may have already been nulled by GC.
+	for (int32 ServiceIndex = Services.Num() - 1; ServiceIndex >= 0; --ServiceIndex)
+	{
+		if (!IsValid(Services[ServiceIndex]))
+		{
+			InvalidateService(ServiceIndex);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::InvalidateService(int32 ServiceIndex)
+{
+	UObject* ServiceInstance = Services[ServiceIndex];
+	const int32 DescriptorIndex = ServiceRecords[ServiceIndex].DescriptorIndex;
+
+	// A replacement mustn't be located while the destroyed service is still warming up
+	WaitForServiceWarmUp(ServiceInstance);
+
+	UE_LOG(LogUnrealServiceLocator, Log, TEXT("UServiceLocatorContainer::InvalidateService: Service '%s' from element '%d' in config '%s' was destroyed, and has been unmapped from container '%s'"),
+		*GetNameSafe(ServiceInstance), DescriptorIndex, *GetNameSafe(ActiveConfig), *GetNameSafe(this));
+
+	Services.RemoveAt(ServiceIndex);
+	ServiceRecords.RemoveAt(ServiceIndex);
+
+	UnmapService(ServiceInstance);
+
+	if ((ActiveConfig == nullptr) || !ActiveConfig->ServiceDescriptors.IsValidIndex(DescriptorIndex))
+	{
+		return;
+	}
+
+	const FServiceDescriptor& ServiceDescriptor = ActiveConfig->ServiceDescriptors[DescriptorIndex];
+	switch (ServiceDescriptor.RecoveryBehaviour)
+	{
+		case EServiceRecoveryBehaviour::Immediate:
+		{
+			PendingRecoveryDescriptorIndices.AddUnique(DescriptorIndex);
+			StartTicking();
+			break;
+		}
+
+		case EServiceRecoveryBehaviour::OnNextLookup:
+		{
+			for (const TSoftClassPtr<UObject>& MappedType : ServiceDescriptor.MappedTypes)
+			{
+				if (UClass* LoadedMappedType = MappedType.Get())
+				{
+					LazyRecoveryTypes.Emplace(LoadedMappedType, DescriptorIndex);
+				}
+			}
+			break;
+		}
+
+		default:
+		{
+			break;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::UnmapService(UObject* ServiceInstance)
+{
+	for (TMap<UClass*, UObject*>::TIterator Iter = MappedTypesToServices.CreateIterator(); Iter; ++Iter)
+	{
+		if (Iter.Value() != ServiceInstance)
+		{
+			continue;
+		}
+
+#if SERVICE_LOCATOR_THREAD_CHECKS
+		GameThreadOnlyMappedTypes.Remove(Iter.Key());
+#endif
+		Iter.RemoveCurrent();
+	}
+
+	// Keyed services are removed in place, so that the remaining ones keep their order
+	for (TPair<UClass*, FKeyedServices>& TypeKeyedServices : KeyedServices)
+	{
+		for (int32 KeyIndex = TypeKeyedServices.Value.Instances.Num() - 1; KeyIndex >= 0; --KeyIndex)
+		{
+			if (TypeKeyedServices.Value.Instances[KeyIndex] == ServiceInstance)
+			{
+				TypeKeyedServices.Value.Keys.RemoveAt(KeyIndex);
+				TypeKeyedServices.Value.Instances.RemoveAt(KeyIndex);
+			}
+		}
+	}
+
+#if SERVICE_LOCATOR_OVERRIDES
+	for (TPair<UClass*, FServiceOverride>& ServiceOverride : ServiceOverrides)
+	{
+		if (ServiceOverride.Value.UnderlyingInstance == ServiceInstance)
+		{
+			ServiceOverride.Value.UnderlyingInstance = nullptr;
+		}
+	}
+#endif
+
+	++ServicesGeneration;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+UObject* UServiceLocatorContainer::RecoverService(const UClass* ServiceClass)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_RecoverService);
+	check(IsInGameThread());
+
+	if (!IsValid(ServiceClass))
+	{
+		return nullptr;
+	}
+
+	InvalidateDestroyedServices();
+
+	UObject* const* FoundService = MappedTypesToServices.Find(ServiceClass);
+	if ((FoundService != nullptr) && !IsValid(*FoundService))
+	{
+		// Not a service this container located, e.g. a registered service
+		UnmapService(*FoundService);
+	}
+
+	const int32* DescriptorIndex = LazyRecoveryTypes.Find(ServiceClass);
+	if (DescriptorIndex != nullptr)
+	{
+		RecoverDescriptor(*DescriptorIndex);
+	}
+
+	return MappedTypesToServices.FindRef(const_cast<UClass*>(ServiceClass));
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::RecoverDescriptor(int32 DescriptorIndex)
+{
+	for (TMap<const UClass*, int32>::TIterator Iter = LazyRecoveryTypes.CreateIterator(); Iter; ++Iter)
+	{
+		if (Iter.Value() == DescriptorIndex)
+		{
+			Iter.RemoveCurrent();
+		}
+	}
+
+	PendingRecoveryDescriptorIndices.Remove(DescriptorIndex);
+
+	// Don't bring services back while the world is being torn down
+	UWorld* LocalWorld = GetWorld();
+	if ((LocalWorld != nullptr) && LocalWorld->bIsTearingDown)
+	{
+		return;
+	}
+
+	if ((ActiveConfig == nullptr) || !ActiveConfig->ServiceDescriptors.IsValidIndex(DescriptorIndex))
+	{
+		return;
+	}
+
+	UE_LOG(LogUnrealServiceLocator, Log, TEXT("UServiceLocatorContainer::RecoverDescriptor: Recovering service from element '%d' in config '%s' for container '%s'"),
+		DescriptorIndex, *GetNameSafe(ActiveConfig), *GetNameSafe(this));
+
+	const int32 NumServices = Services.Num();
+	{
+		// A recreated actor service is injected before it finishes spawning, as when locating
+		TGuardValue<bool> DeferActorServiceSpawning(bDeferActorServiceSpawning, true);
+		LocateAndCreateService(ActiveConfig->ServiceDescriptors[DescriptorIndex], DescriptorIndex);
+	}
+
+	// Services located asynchronously are set up together once location finishes
+	if ((Services.Num() > NumServices) && !IsLocatingServices())
+	{
+		FinishRecoveringService(Services.Last());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::FinishRecoveringService(UObject* ServiceInstance)
+{
+	FinishSpawningActorServices();
+
+	// The same steps as FinishLocatingServices(). Every service and target is injected again, as they may hold the destroyed service.
+	for (UObject* Service : Services)
+	{
+		if (IsValid(Service))
+		{
+			InjectServicesInternal(Service);
+		}
+	}
+
+	for (const TWeakObjectPtr<UObject>& InjectionTarget : InjectionTargets)
+	{
+		if (UObject* Target = InjectionTarget.Get())
+		{
+			InjectServicesInternal(Target);
+		}
+	}
+
+	UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::FinishRecoveringService: Recovered service '%s' for container '%s'"),
+		*GetNameSafe(ServiceInstance), *GetNameSafe(this));
+
+	// Only services which haven't been warmed up yet are warmed up, i.e. the recovered one
+	StartWarmingUpServices();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::TickPendingRecovery()
+{
+	TArray<int32> DescriptorIndices = MoveTemp(PendingRecoveryDescriptorIndices);
+	for (int32 DescriptorIndex : DescriptorIndices)
+	{
+		RecoverDescriptor(DescriptorIndex);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorContainer_Private
+{
+
+	// The minimum time between warnings about a service overrunning its tick budget, so that a slow service doesn't flood the log
+	const double TickOverrunWarningInterval = 5.0;
+
+} // namespace ServiceLocatorContainer_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::RebuildTickedServices()
+{
+	TickedServicesGeneration = ServicesGeneration;
+
+	// Timings are carried over, so that they survive services being added or removed
+	TArray<FTickedService> PreviousTickedServices = MoveTemp(TickedServices);
+	TickedServices.Reset();
+
+	if (ActiveConfig == nullptr)
+	{
+		return;
+	}
+
+	const TArray<FServiceDescriptor>& ServiceDescriptors = ActiveConfig->ServiceDescriptors;
+	TArray<const FServiceTickSettings*, TInlineAllocator<16>> TickSettings;
+
+	for (int32 ServiceIndex = 0; ServiceIndex < Services.Num(); ++ServiceIndex)
+	{
+		UObject* ServiceInstance = Services[ServiceIndex];
+		IServiceTickInterface* TickInterface = Cast<IServiceTickInterface>(ServiceInstance);
+		if (!IsValid(ServiceInstance) || (TickInterface == nullptr) || !ServiceDescriptors.IsValidIndex(ServiceRecords[ServiceIndex].DescriptorIndex))
+		{
+			continue;
+		}
+
+		const FServiceTickSettings& ServiceTickSettings = ServiceDescriptors[ServiceRecords[ServiceIndex].DescriptorIndex].TickSettings;
+
+		const FTickedService* PreviousTickedService = PreviousTickedServices.FindByPredicate([ServiceInstance](const FTickedService& Ticked) { return Ticked.Service.Get() == ServiceInstance; });
+		FTickedService& TickedService = (PreviousTickedService != nullptr) ? TickedServices.Emplace_GetRef(*PreviousTickedService) : TickedServices.AddDefaulted_GetRef();
+		TickedService.Service = ServiceInstance;
+		TickedService.TickInterface = TickInterface;
+		TickedService.Wave = 0;
+		TickedService.Priority = ServiceTickSettings.Priority;
+		TickedService.bParallel = ServiceTickSettings.bTickInParallel;
+		TickedService.BudgetMs = ServiceTickSettings.BudgetMs;
+
+		TickSettings.Emplace(&ServiceTickSettings);
+	}
+
+	// Prerequisites are resolved to whichever services are mapped to them now, so an unmapped prerequisite is ignored
+	TArray<TArray<int32, TInlineAllocator<4>>, TInlineAllocator<16>> PrerequisiteIndices;
+	PrerequisiteIndices.SetNum(TickedServices.Num());
+
+	for (int32 TickedIndex = 0; TickedIndex < TickedServices.Num(); ++TickedIndex)
+	{
+		for (const TSoftClassPtr<UObject>& Prerequisite : TickSettings[TickedIndex]->Prerequisites)
+		{
+			UObject* PrerequisiteService = MappedTypesToServices.FindRef(Prerequisite.Get());
+			const int32 PrerequisiteIndex = TickedServices.IndexOfByPredicate([PrerequisiteService](const FTickedService& Ticked) { return Ticked.Service.Get() == PrerequisiteService; });
+			if ((PrerequisiteService != nullptr) && (PrerequisiteIndex != INDEX_NONE) && (PrerequisiteIndex != TickedIndex))
+			{
+				PrerequisiteIndices[TickedIndex].Emplace(PrerequisiteIndex);
+			}
+		}
+	}
+
+	// Each service's wave is one past its latest prerequisite's. A chain can't be longer than the number of services,
+	// so waves which are still changing after that many passes are part of a cycle.
+	bool bWavesChanged = true;
+	for (int32 Pass = 0; bWavesChanged && (Pass <= TickedServices.Num()); ++Pass)
+	{
+		bWavesChanged = false;
+
+		for (int32 TickedIndex = 0; TickedIndex < TickedServices.Num(); ++TickedIndex)
+		{
+			for (int32 PrerequisiteIndex : PrerequisiteIndices[TickedIndex])
+			{
+				if (TickedServices[TickedIndex].Wave <= TickedServices[PrerequisiteIndex].Wave)
+				{
+					TickedServices[TickedIndex].Wave = TickedServices[PrerequisiteIndex].Wave + 1;
+					bWavesChanged = true;
+				}
+			}
+		}
+	}
+
+	if (bWavesChanged)
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::RebuildTickedServices: Tick prerequisites of services in container '%s' form a cycle, so some services may tick before their prerequisites"),
+			*GetNameSafe(this));
+	}
 
-	for (TArray<FServiceDescriptor>::TConstIterator Iter = ServiceDescriptors.CreateConstIterator(); Iter; ++Iter)
+	// Parallel services come first within each wave, so that they're contiguous
+	TickedServices.StableSort([](const FTickedService& A, const FTickedService& B)
 	{
-		const FServiceDescriptor& ServiceDescriptor = *Iter;
+		if (A.Wave != B.Wave)
+		{
+			return A.Wave < B.Wave;
+		}
 
-		UClass* ServiceType = ServiceDescriptor.ServiceType;
-		if (ServiceType == nullptr)
+		if (A.bParallel != B.bParallel)
 		{
-			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateServices: ServiceType is null for element '%d' in config '%s'"),
-				Iter.GetIndex(), *GetNameSafe(Config));
-			continue;
+			return A.bParallel;
+		}
+
+		return A.Priority < B.Priority;
+	});
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::TickServices(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_TickServices);
+
+	if (TickedServicesGeneration != ServicesGeneration)
+	{
+		RebuildTickedServices();
+	}
+
+	const int32 NumTickedServices = TickedServices.Num();
+	int32 WaveStart = 0;
+
+	while (WaveStart < NumTickedServices)
+	{
+		const int32 Wave = TickedServices[WaveStart].Wave;
+
+		int32 ParallelEnd = WaveStart;
+		while ((ParallelEnd < NumTickedServices) && (TickedServices[ParallelEnd].Wave == Wave) && TickedServices[ParallelEnd].bParallel)
+		{
+			++ParallelEnd;
 		}
 
-		if (ServiceType->HasAnyClassFlags(CLASS_Abstract | CLASS_Interface))
+		int32 WaveEnd = ParallelEnd;
+		while ((WaveEnd < NumTickedServices) && (TickedServices[WaveEnd].Wave == Wave))
 		{
-			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateServices: ServiceType has Abstract or Interface class flags for element '%d' in config '%s'"),
-				Iter.GetIndex(), *GetNameSafe(Config));
-			continue;
+			++WaveEnd;
 		}
 
-		// If this is a debug only service and we're running a shipping build, skip this service
-		if (ServiceDescriptor.bDebugOnly && UE_BUILD_SHIPPING)
+		if ((ParallelEnd - WaveStart) > 1)
 		{
-			continue;
+			ParallelFor(ParallelEnd - WaveStart, [this, WaveStart, DeltaTime](int32 Index)
+			{
+				TickService(TickedServices[WaveStart + Index], DeltaTime);
+			});
+		}
+		else if (ParallelEnd > WaveStart)
+		{
+			TickService(TickedServices[WaveStart], DeltaTime);
 		}
 
-		UObject* ServiceInstance = LocateOrCreateService(ServiceDescriptor);
-		if (ServiceInstance == nullptr)
+		for (int32 TickedIndex = ParallelEnd; TickedIndex < WaveEnd; ++TickedIndex)
 		{
-			continue;
+			TickService(TickedServices[TickedIndex], DeltaTime);
 		}
 
-		Services.Emplace(ServiceInstance);
+		WaveStart = WaveEnd;
+	}
 
-		for (UClass* MappedType : ServiceDescriptor.MappedTypes)
+	// Overruns are reported here rather than as they happen, so that workers never log
+	const double CurrentTime = FPlatformTime::Seconds();
+	for (FTickedService& TickedService : TickedServices)
+	{
+		if ((TickedService.NumUnreportedOverruns > 0) && ((CurrentTime - TickedService.LastOverrunWarningTime) >= ServiceLocatorContainer_Private::TickOverrunWarningInterval))
 		{
-			if (MappedType == nullptr)
-			{
-				continue;
-			}
+			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::TickServices: Service '%s' took %.3fms to tick, over its budget of %.3fms (%d overruns since the last warning)"),
+				*GetNameSafe(TickedService.Service.Get()), TickedService.LastMilliseconds, TickedService.BudgetMs, TickedService.NumUnreportedOverruns);
 
-			if (MappedType->HasAnyClassFlags(CLASS_Interface))
-			{
-				if (!ServiceType->ImplementsInterface(MappedType))
-				{
-					UE_LOG(LogUnrealServiceLocator, Error, TEXT("UServiceLocatorContainer::LocateOrCreateServices: ServiceType '%s' doesn't implement MappedType '%s'"),
-						*GetNameSafe(ServiceType), *GetNameSafe(MappedType));
-					continue;
-				}
-			}
-			else if (!ServiceType->IsChildOf(MappedType))
-			{
-				UE_LOG(LogUnrealServiceLocator, Error, TEXT("UServiceLocatorContainer::LocateOrCreateServices: ServiceType '%s' isn't a child of MappedType '%s'"),
-					*GetNameSafe(ServiceType), *GetNameSafe(MappedType));
-				continue;
-			}
+			TickedService.NumUnreportedOverruns = 0;
+			TickedService.LastOverrunWarningTime = CurrentTime;
+		}
+	}
+}
 
-			UObject** ExistingMappedTypeService = MappedTypesToServices.Find(MappedType);
-			if (ExistingMappedTypeService != nullptr)
-			{
-				UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateServices: Type '%s' is already mapped to Service '%s', but will be displaced by ServiceType '%s'"),
-					*GetNameSafe(MappedType), *GetNameSafe(*ExistingMappedTypeService), *GetNameSafe(ServiceType));
-			}
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::TickService(FTickedService& TickedService, float DeltaTime)
+{
+	if (!TickedService.Service.IsValid())
+	{
+		return;
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	TickedService.TickInterface->TickService(DeltaTime);
+	const double Milliseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	TickedService.LastMilliseconds = Milliseconds;
+	TickedService.PeakMilliseconds = FMath::Max(TickedService.PeakMilliseconds, Milliseconds);
+
+	if ((TickedService.BudgetMs > 0.0f) && (Milliseconds > TickedService.BudgetMs))
+	{
+		++TickedService.NumOverruns;
+		++TickedService.NumUnreportedOverruns;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::GetServiceTickTimings(TArray<FServiceTickTiming>& OutTimings) const
+{
+	OutTimings.Reset(TickedServices.Num());
 
-			MappedTypesToServices.Emplace(MappedType, ServiceInstance);
+	for (const FTickedService& TickedService : TickedServices)
+	{
+		const UObject* ServiceInstance = TickedService.Service.Get();
+		if (ServiceInstance == nullptr)
+		{
+			continue;
 		}
+
+		FServiceTickTiming& Timing = OutTimings.AddDefaulted_GetRef();
+		Timing.ServiceName = ServiceInstance->GetFName();
+		Timing.ServiceType = ServiceInstance->GetClass();
+		Timing.LastMilliseconds = TickedService.LastMilliseconds;
+		Timing.PeakMilliseconds = TickedService.PeakMilliseconds;
+		Timing.NumOverruns = TickedService.NumOverruns;
+		Timing.bParallel = TickedService.bParallel;
 	}
 }
 
 ///////////////////////////////////////////////////////////////////////////
 
 UObject* UServiceLocatorContainer::GetServiceInternal(const UClass* ServiceClass) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_GetServiceInternal);
+
+	if (!IsValid(ServiceClass))
+	{
+		return nullptr;
+	}
+
+	return GetServiceInternalByHash(ServiceClass, GetTypeHash(ServiceClass));
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+UObject* UServiceLocatorContainer::GetServiceInternalByHash(const UClass* ServiceClass, uint32 ServiceClassHash) const
+{
+	INC_DWORD_STAT(STAT_UServiceLocatorContainer_GetServiceInternal_FrameCalls);
+	INC_DWORD_STAT(STAT_UServiceLocatorContainer_GetServiceInternal_TotalCalls);
+
+#if SERVICE_LOCATOR_THREAD_CHECKS
+	ensureMsgf(IsInGameThread() || !GameThreadOnlyMappedTypes.Contains(ServiceClass),
+		TEXT("UServiceLocatorContainer::GetServiceInternal: Type '%s' is mapped to a game thread only service, but was retrieved from another thread. Use GetQueuedServiceProxy() instead."),
+		*GetNameSafe(ServiceClass));
+#endif
+
+	// A pure find. Destroyed services are unmapped when they're noticed, or recovered through GetOrRecoverService(), but
+	// may still be mapped until then, e.g. a component destroyed on its own, so they're never returned.
+	UObject* const* FoundService = MappedTypesToServices.FindByHash(ServiceClassHash, ServiceClass);
+	return ((FoundService != nullptr) && IsValid(*FoundService)) ? *FoundService : nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+UObject* UServiceLocatorContainer::GetKeyedServiceInternal(const UClass* ServiceClass, FName Key) const
 {
 	INC_DWORD_STAT(STAT_UServiceLocatorContainer_GetServiceInternal_FrameCalls);
 	INC_DWORD_STAT(STAT_UServiceLocatorContainer_GetServiceInternal_TotalCalls);
 	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_GetServiceInternal);
 
-	if (!IsValid(ServiceClass))
+	const FKeyedServices* TypeKeyedServices = KeyedServices.Find(const_cast<UClass*>(ServiceClass));
+	if (TypeKeyedServices == nullptr)
 	{
 		return nullptr;
 	}
 
-	UObject* const* FoundService = MappedTypesToServices.Find(ServiceClass);
-	if (FoundService != nullptr)
+	// There are only ever a handful of keys per type, so a linear scan beats hashing
+	const int32 KeyIndex = TypeKeyedServices->Keys.IndexOfByKey(Key);
+	if (KeyIndex == INDEX_NONE)
 	{
-		return *FoundService;
+		return nullptr;
 	}
 
-	return nullptr;
+	UObject* ServiceInstance = TypeKeyedServices->Instances[KeyIndex];
+	return IsValid(ServiceInstance) ? ServiceInstance : nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+EServiceState UServiceLocatorContainer::GetServiceStateInternal(const UClass* ServiceClass) const
+{
+	if (!IsValid(ServiceClass))
+	{
+		return EServiceState::Unavailable;
+	}
+
+	if (MappedTypesToServices.Contains(ServiceClass))
+	{
+		return EServiceState::Ready;
+	}
+
+	return PendingMappedTypes.Contains(ServiceClass) ? EServiceState::Pending : EServiceState::Unavailable;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::FlushQueuedServiceCalls()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_FlushQueuedServiceCalls);
+
+	const int32 NumCalls = QueuedServiceCalls->Drain();
+	INC_DWORD_STAT_BY(STAT_UServiceLocatorContainer_QueuedServiceCalls_FrameCalls, NumCalls);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::DispatchServiceEvents()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_DispatchServiceEvents);
+
+	EventBus.Dispatch();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::StartTicking()
+{
+	check(IsInGameThread());
+
+	if (!Ticker.IsValid() && !HasAnyFlags(RF_ClassDefaultObject) && !HasAnyFlags(RF_BeginDestroyed))
+	{
+		Ticker = MakeUnique<FContainerTicker>(*this);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+TFunction<void()> UServiceLocatorContainer::MakeStartTickingFunction()
+{
+	return [WeakThis = TWeakObjectPtr<UServiceLocatorContainer>(this)]()
+	{
+		auto StartTicking = [WeakThis]()
+		{
+			if (UServiceLocatorContainer* Container = WeakThis.Get())
+			{
+				Container->StartTicking();
+			}
+		};
+
+		if (IsInGameThread())
+		{
+			StartTicking();
+		}
+		else
+		{
+			AsyncTask(ENamedThreads::GameThread, MoveTemp(StartTicking));
+		}
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::Tick(float DeltaTime)
+{
+	// Before recovery, so that services destroyed since the last tick are recovered this frame
+	InvalidateDestroyedServices();
+
+	if (IsLocatingServices())
+	{
+		TickAsyncLocate();
+	}
+
+	if (PendingRecoveryDescriptorIndices.Num() > 0)
+	{
+		TickPendingRecovery();
+	}
+
+	// Queued calls are drained after location, so that calls for services located this frame are run straight away
+	if (!QueuedServiceCalls->IsEmpty())
+	{
+		FlushQueuedServiceCalls();
+	}
+
+	// Services tick before events are dispatched, so that events published while ticking are handled this frame
+	if ((TickedServices.Num() > 0) || (TickedServicesGeneration != ServicesGeneration))
+	{
+		TickServices(DeltaTime);
+	}
+
+	if (EventBus.HasPendingEvents())
+	{
+		DispatchServiceEvents();
+	}
+
+	if (WarmUpTasks.Num() > 0)
+	{
+		FinishWarmingUpServices();
+	}
+
+	// Calls and events queued from other threads from now on start ticking again through their callbacks
+	if (!HasTickWork())
+	{
+		Ticker.Reset();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+bool UServiceLocatorContainer::HasTickWork() const
+{
+	return IsLocatingServices() || (PendingRecoveryDescriptorIndices.Num() > 0) || !QueuedServiceCalls->IsEmpty() || EventBus.HasPendingEvents()
+		|| (TickedServices.Num() > 0) || (TickedServicesGeneration != ServicesGeneration) || (WarmUpTasks.Num() > 0);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+TStatId UServiceLocatorContainer::FContainerTicker::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UServiceLocatorContainer, STATGROUP_UnrealServiceLocator);
 }
 
 ///////////////////////////////////////////////////////////////////////////
 
-UObject* UServiceLocatorContainer::LocateOrCreateService(const FServiceDescriptor& ServiceDescriptor)
+UObject* UServiceLocatorContainer::LocateOrCreateService(const FServiceDescriptor& ServiceDescriptor, bool& bOutCreated, bool bSkipLocate)
 {
-	if (ServiceDescriptor.ServiceType->IsChildOf<AActor>())
+	UClass* ServiceType = ServiceDescriptor.GetServiceType();
+	if (ServiceType == nullptr)
 	{
-		return LocateOrCreateActorService(ServiceDescriptor);
+		return nullptr;
+	}
+
+	if (ServiceType->IsChildOf<AActor>())
+	{
+		return LocateOrCreateActorService(ServiceDescriptor, bOutCreated, bSkipLocate);
 	}
 
-	if (ServiceDescriptor.ServiceType->IsChildOf<UActorComponent>())
+	if (ServiceType->IsChildOf<UActorComponent>())
 	{
-		return LocateOrCreateComponentService(ServiceDescriptor);
+		return LocateOrCreateComponentService(ServiceDescriptor, bOutCreated, bSkipLocate);
 	}
 
-	return LocateOrCreateObjectService(ServiceDescriptor);
+	return LocateOrCreateObjectService(ServiceDescriptor, bOutCreated, bSkipLocate);
 }
 
 ///////////////////////////////////////////////////////////////////////////
 
-AActor* UServiceLocatorContainer::LocateOrCreateActorService(const FServiceDescriptor& ServiceDescriptor)
+AActor* UServiceLocatorContainer::LocateOrCreateActorService(const FServiceDescriptor& ServiceDescriptor, bool& bOutCreated, bool bSkipLocate)
 {
 	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_LocateOrCreateActorService);
 
@@ -165,52 +2470,158 @@ AActor* UServiceLocatorContainer::LocateOrCreateActorService(const FServiceDescr
 	}
 
 	// Look for an instance of this service already in the world
-	for (AActor* ServiceInstance : TActorRange<AActor>(LocalWorld, ServiceDescriptor.ServiceType))
+	if (!bSkipLocate)
 	{
-		return ServiceInstance;
+		for (AActor* ServiceInstance : TActorRange<AActor>(LocalWorld, ServiceDescriptor.GetServiceType()))
+		{
+			return ServiceInstance;
+		}
 	}
 
 	// We need to bail here if we can only find the service, not create it
 	if (ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::FindOnly)
 	{
-		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Unable to find instance of actor service with type '%s'"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
+		UE_LOG(LogUnrealServiceLocator, Log, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Unable to find instance of actor service with type '%s', it will be mapped if it streams in later"),
+			*GetNameSafe(ServiceDescriptor.GetServiceType()));
 		return nullptr;
 	}
 
-	// If we should only create this if we're the server, but we're not the server, bail
-	if ((ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::CreateIfNotFoundServerOnly) && !LocalWorld->IsServer())
+	// Server and client only services can't be created in the wrong net mode, which was evaluated along with the descriptor conditions
+	if (!CanCreateService(ServiceDescriptor))
 	{
-		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Unable to find instance of actor service with type '%s', unable to create due to not being the server"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
+		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Unable to find instance of actor service with type '%s', unable to create in this net mode"),
+			*GetNameSafe(ServiceDescriptor.GetServiceType()));
 		return nullptr;
 	}
 
-	// If we should only create this if we're a client, but we're the server, bail
-	if ((ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::CreateIfNotFoundClientOnly) && LocalWorld->IsServer())
+	// Create a new instance of the service
+	AActor* ServiceInstance = nullptr;
+	if (ServiceDescriptor.Factory != nullptr)
 	{
-		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Unable to find instance of actor service with type '%s', unable to create due to being the server"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
-		return nullptr;
+		ServiceInstance = Cast<AActor>(ServiceDescriptor.Factory->CreateService(this, ServiceDescriptor));
+
+		// The factory has already spawned the actor, so only injection is left to the container
+		if (ServiceInstance != nullptr)
+		{
+			UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Actor service '%s' was created by factory '%s', so its SpawnSettings are left to the factory"),
+				*GetNameSafe(ServiceInstance), *GetNameSafe(ServiceDescriptor.Factory));
+
+			if (bDeferActorServiceSpawning)
+			{
+				DeferredActorServices.Emplace(FDeferredActorService{ ServiceInstance, ServiceInstance->GetActorTransform(), false /* bFinishSpawning */ });
+			}
+			else
+			{
+				InjectServicesInternal(ServiceInstance);
+			}
+		}
+	}
+	else
+	{
+		const FServiceSpawnSettings& SpawnSettings = ServiceDescriptor.SpawnSettings;
+
+		FActorSpawnParameters ActorSpawnParameters;
+		ActorSpawnParameters.ObjectFlags = RF_Transient;
+		ActorSpawnParameters.Owner = SpawnSettings.bOwnedByContainerActor ? GetTypedOuter<AActor>() : nullptr;
+		ActorSpawnParameters.OverrideLevel = GetSpawnLevel(SpawnSettings);
+		ActorSpawnParameters.SpawnCollisionHandlingOverride = SpawnSettings.CollisionHandling;
+
+		// Construction is deferred, so that services are injected before the actor's construction script runs and its components register
+		ActorSpawnParameters.bDeferConstruction = true;
+
+		ServiceInstance = LocalWorld->SpawnActor<AActor>(ServiceDescriptor.GetServiceType(), SpawnSettings.Transform, ActorSpawnParameters);
+		if (ServiceInstance != nullptr)
+		{
+			if (bDeferActorServiceSpawning)
+			{
+				DeferredActorServices.Emplace(FDeferredActorService{ ServiceInstance, SpawnSettings.Transform });
+			}
+			else
+			{
+				InjectServicesInternal(ServiceInstance);
+				ServiceInstance->FinishSpawning(SpawnSettings.Transform);
+			}
+		}
 	}
 
-	// Create a new instance of the service
-	FActorSpawnParameters ActorSpawnParameters;
-	ActorSpawnParameters.ObjectFlags = RF_Transient;
-	AActor* ServiceInstance = LocalWorld->SpawnActor<AActor>(ServiceDescriptor.ServiceType, ActorSpawnParameters);
 	if (ServiceInstance == nullptr)
 	{
 		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Unable to spawn instance of actor service with type '%s'"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
+			*GetNameSafe(ServiceDescriptor.GetServiceType()));
 		return nullptr;
 	}
 
+	bOutCreated = true;
 	return ServiceInstance;
 }
 
 ///////////////////////////////////////////////////////////////////////////
 
-UActorComponent* UServiceLocatorContainer::LocateOrCreateComponentService(const FServiceDescriptor& ServiceDescriptor)
+ULevel* UServiceLocatorContainer::GetSpawnLevel(const FServiceSpawnSettings& SpawnSettings) const
+{
+	if (SpawnSettings.Level.IsNull())
+	{
+		return nullptr;
+	}
+
+	UWorld* LocalWorld = GetWorld();
+	if (LocalWorld == nullptr)
+	{
+		return nullptr;
+	}
+
+	const FString LevelPackageName = SpawnSettings.Level.GetLongPackageName();
+
+	for (ULevel* Level : LocalWorld->GetLevels())
+	{
+		// Levels loaded in PIE have their package names prefixed
+		if ((Level != nullptr) && (UWorld::RemovePIEPrefix(Level->GetOutermost()->GetName()) == LevelPackageName))
+		{
+			return Level;
+		}
+	}
+
+	UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::GetSpawnLevel: Level '%s' isn't loaded, spawning into the persistent level instead"),
+		*LevelPackageName);
+	return nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UServiceLocatorContainer::FinishSpawningActorServices()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_FinishSpawningActorServices);
+
+	if (DeferredActorServices.Num() == 0)
+	{
+		return;
+	}
+
+	// Finishing spawning may locate further services, e.g. from BeginPlay, which mustn't be added to this batch
+	TArray<FDeferredActorService> ActorServicesToFinish = MoveTemp(DeferredActorServices);
+	TGuardValue<bool> DeferActorServiceSpawning(bDeferActorServiceSpawning, false);
+
+	// Every actor service in the batch has been constructed and mapped by now, so they can be injected with each other
+	for (const FDeferredActorService& DeferredActorService : ActorServicesToFinish)
+	{
+		if (IsValid(DeferredActorService.Actor))
+		{
+			InjectServicesInternal(DeferredActorService.Actor);
+		}
+	}
+
+	for (const FDeferredActorService& DeferredActorService : ActorServicesToFinish)
+	{
+		if (DeferredActorService.bFinishSpawning && IsValid(DeferredActorService.Actor))
+		{
+			DeferredActorService.Actor->FinishSpawning(DeferredActorService.SpawnTransform);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+UActorComponent* UServiceLocatorContainer::LocateOrCreateComponentService(const FServiceDescriptor& ServiceDescriptor, bool& bOutCreated, bool bSkipLocate)
 {
 	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_LocateOrCreateComponentService);
 
@@ -226,7 +2637,7 @@ UActorComponent* UServiceLocatorContainer::LocateOrCreateComponentService(const
 	UActorComponent* ServiceInstance = nullptr;
 
 	// Look for an instance of this service already in the actor
-	ServiceInstance = OuterAsActor->FindComponentByClass(ServiceDescriptor.ServiceType);
+	ServiceInstance = bSkipLocate ? nullptr : OuterAsActor->FindComponentByClass(ServiceDescriptor.GetServiceType());
 	if (ServiceInstance != nullptr)
 	{
 		return ServiceInstance;
@@ -236,47 +2647,50 @@ UActorComponent* UServiceLocatorContainer::LocateOrCreateComponentService(const
 	if (ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::FindOnly)
 	{
 		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateComponentService: Unable to find instance of component service with type '%s'"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
+			*GetNameSafe(ServiceDescriptor.GetServiceType()));
 		return nullptr;
 	}
 
-	// If we should only create this if we're the server, but we're not the server, bail
-	if ((ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::CreateIfNotFoundServerOnly) && ((OuterAsActor->GetWorld() == nullptr) || !OuterAsActor->GetWorld()->IsServer()))
+	// Server and client only services can't be created in the wrong net mode, which was evaluated along with the descriptor conditions
+	if (!CanCreateService(ServiceDescriptor))
 	{
-		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Unable to find instance of component service with type '%s', unable to create due to not being the server"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
+		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LocateOrCreateComponentService: Unable to find instance of component service with type '%s', unable to create in this net mode"),
+			*GetNameSafe(ServiceDescriptor.GetServiceType()));
 		return nullptr;
 	}
 
-	// If we should only create this if we're a client, but we're the server, bail
-	if ((ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::CreateIfNotFoundClientOnly) && ((OuterAsActor->GetWorld() == nullptr) || OuterAsActor->GetWorld()->IsServer()))
+	if (ServiceDescriptor.Factory != nullptr)
 	{
-		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Unable to find instance of component service with type '%s', unable to create due to being the server"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
-		return nullptr;
+		ServiceInstance = Cast<UActorComponent>(ServiceDescriptor.Factory->CreateService(this, ServiceDescriptor));
+	}
+	else
+	{
+		ServiceInstance = NewObject<UActorComponent>(OuterAsActor, ServiceDescriptor.GetServiceType(), NAME_None, RF_Transient);
+		if (ServiceInstance != nullptr)
+		{
+			ServiceInstance->CreationMethod = EComponentCreationMethod::Instance;
+			ServiceInstance->RegisterComponent();
+		}
 	}
 
-	ServiceInstance = NewObject<UActorComponent>(OuterAsActor, ServiceDescriptor.ServiceType, NAME_None, RF_Transient);
 	if (ServiceInstance == nullptr)
 	{
 		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateComponentService: Unable to create instance of component service with type '%s'"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
+			*GetNameSafe(ServiceDescriptor.GetServiceType()));
 		return nullptr;
 	}
 
-	ServiceInstance->CreationMethod = EComponentCreationMethod::Instance;
-	ServiceInstance->RegisterComponent();
-
+	bOutCreated = true;
 	return ServiceInstance;
 }
 
 ///////////////////////////////////////////////////////////////////////////
 
-UObject* UServiceLocatorContainer::LocateOrCreateObjectService(const FServiceDescriptor& ServiceDescriptor)
+UObject* UServiceLocatorContainer::LocateOrCreateObjectService(const FServiceDescriptor& ServiceDescriptor, bool& bOutCreated, bool bSkipLocate)
 {
 	SCOPE_CYCLE_COUNTER(STAT_UServiceLocatorContainer_LocateOrCreateObjectService);
 
-	UObject* ServiceInstance = static_cast<UObject*>(FindObjectWithOuter(GetOuter(), ServiceDescriptor.ServiceType));
+	UObject* ServiceInstance = bSkipLocate ? nullptr : static_cast<UObject*>(FindObjectWithOuter(GetOuter(), ServiceDescriptor.GetServiceType()));
 	if (ServiceInstance != nullptr)
 	{
 		return ServiceInstance;
@@ -286,34 +2700,35 @@ UObject* UServiceLocatorContainer::LocateOrCreateObjectService(const FServiceDes
 	if (ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::FindOnly)
 	{
 		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateObjectService: Unable to find instance of object service with type '%s'"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
+			*GetNameSafe(ServiceDescriptor.GetServiceType()));
 		return nullptr;
 	}
 
-	// If we should only create this if we're the server, but we're not the server, bail
-	if ((ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::CreateIfNotFoundServerOnly) && ((GetWorld() == nullptr) || !GetWorld()->IsServer()))
+	// Server and client only services can't be created in the wrong net mode, which was evaluated along with the descriptor conditions
+	if (!CanCreateService(ServiceDescriptor))
 	{
-		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Unable to find instance of object service with type '%s', unable to create due to not being the server"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
+		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LocateOrCreateObjectService: Unable to find instance of object service with type '%s', unable to create in this net mode"),
+			*GetNameSafe(ServiceDescriptor.GetServiceType()));
 		return nullptr;
 	}
 
-	// If we should only create this if we're a client, but we're the server, bail
-	if ((ServiceDescriptor.LocateBehaviour == EServiceLocationBehaviour::CreateIfNotFoundClientOnly) && ((GetWorld() == nullptr) || GetWorld()->IsServer()))
+	if (ServiceDescriptor.Factory != nullptr)
 	{
-		UE_LOG(LogUnrealServiceLocator, Verbose, TEXT("UServiceLocatorContainer::LocateOrCreateActorService: Unable to find instance of object service with type '%s', unable to create due to being the server"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
-		return nullptr;
+		ServiceInstance = ServiceDescriptor.Factory->CreateService(this, ServiceDescriptor);
+	}
+	else
+	{
+		ServiceInstance = NewObject<UObject>(GetOuter(), ServiceDescriptor.GetServiceType(), NAME_None, RF_Transient);
 	}
 
-	ServiceInstance = NewObject<UObject>(GetOuter(), ServiceDescriptor.ServiceType, NAME_None, RF_Transient);
 	if (ServiceInstance == nullptr)
 	{
 		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::LocateOrCreateObjectService: Unable to create instance of object service with type '%s'"),
-			*GetNameSafe(ServiceDescriptor.ServiceType));
+			*GetNameSafe(ServiceDescriptor.GetServiceType()));
 		return nullptr;
 	}
 
+	bOutCreated = true;
 	return ServiceInstance;
 }
 
@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorContainerRegistry.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocator
+#include "ServiceLocatorContainerRegistry.h"
+#include "ServiceLocatorContainer.h"
+#include "ServiceLocatorInterface.h"
+
+// Engine
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/Atomic.h"
+#include "UObject/UObjectAnnotation.h"
+#include "UObject/UObjectArray.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorContainerRegistry_Private
+{
+
+	/**
+	 * The offset of IServiceLocatorInterface within each class, read on every lookup from any thread, so it mustn't take a lock.
+	 * Entries are indexed by the class's object index, in chunks allocated as classes with higher indices are seen. Each entry
+	 * packs the class's serial number with the offset into one 64-bit word, so that it's written and read atomically, and an
+	 * entry left behind by a destroyed class never matches a new object reusing its index.
+	 */
+	class FInterfaceOffsetCache
+	{
+	public:
+
+		// Covers 16M object indices, well beyond the largest object array
+		static constexpr int32 ChunkSize	= 16 * 1024;
+		static constexpr int32 MaxChunks	= 1024;
+
+		/**
+		 * @param	OutOffset	Receives the offset, or INDEX_NONE if the class doesn't implement the interface
+		 * @return	bool		Whether the class's offset has been cached
+		 */
+		FORCEINLINE bool Find(int32 ClassIndex, int32 ClassSerialNumber, int32& OutOffset) const
+		{
+			const TAtomic<uint64>* Chunk = (ClassIndex < ChunkSize * MaxChunks) ? Chunks[ClassIndex / ChunkSize].Load() : nullptr;
+			if (Chunk == nullptr)
+			{
+				return false;
+			}
+
+			const uint64 Entry = Chunk[ClassIndex % ChunkSize].Load();
+			if (uint32(Entry >> 32) != uint32(ClassSerialNumber))
+			{
+				return false;
+			}
+
+			OutOffset = int32(uint32(Entry)) - 1;
+			return true;
+		}
+
+		void Add(int32 ClassIndex, int32 ClassSerialNumber, int32 Offset)
+		{
+			if (ClassIndex >= ChunkSize * MaxChunks)
+			{
+				return;
+			}
+
+			TAtomic<TAtomic<uint64>*>& ChunkPtr = Chunks[ClassIndex / ChunkSize];
+			TAtomic<uint64>* Chunk = ChunkPtr.Load();
+			if (Chunk == nullptr)
+			{
+				TAtomic<uint64>* NewChunk = (TAtomic<uint64>*)FMemory::MallocZeroed(ChunkSize * sizeof(TAtomic<uint64>));
+				if (ChunkPtr.CompareExchange(Chunk, NewChunk))
+				{
+					Chunk = NewChunk;
+				}
+				else
+				{
+					// Another thread allocated the chunk first, and Chunk now holds it
+					FMemory::Free(NewChunk);
+				}
+			}
+
+			// Racing writers for the same class write the same value
+			Chunk[ClassIndex % ChunkSize].Store((uint64(uint32(ClassSerialNumber)) << 32) | uint64(uint32(Offset + 1)));
+		}
+
+	private:
+
+		// Never freed, as lookups may be in flight on any thread until the process exits
+		TAtomic<TAtomic<uint64>*> Chunks[MaxChunks];
+
+	};
+
+	static FInterfaceOffsetCache InterfaceOffsetCache;
+
+	struct FAttachedContainerAnnotation
+	{
+		TWeakObjectPtr<UServiceLocatorContainer> Container;
+
+		FORCEINLINE bool IsDefault() const
+		{
+			return Container.IsExplicitlyNull();
+		}
+	};
+
+	static FUObjectAnnotationDense<FAttachedContainerAnnotation, true> AttachedContainerAnnotations;
+
+	// Most projects never attach a container, in which case looking one up shouldn't cost an annotation lookup
+	static FThreadSafeBool bAnyContainersAttached;
+
+	static TAtomic<uint32> ContainersGeneration(0);
+
+} // namespace ServiceLocatorContainerRegistry_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+const IServiceLocatorInterface* FServiceLocatorContainerRegistry::GetObjectAsSLI(const UObject* Object)
+{
+	if (Object == nullptr)
+	{
+		return nullptr;
+	}
+
+	const int32 Offset = GetInterfaceOffset(Object);
+	return (Offset != INDEX_NONE) ? reinterpret_cast<const IServiceLocatorInterface*>((const uint8*)Object + Offset) : nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+int32 FServiceLocatorContainerRegistry::GetInterfaceOffset(const UObject* Object)
+{
+	using namespace ServiceLocatorContainerRegistry_Private;
+
+	check(Object != nullptr);
+
+	// Every instance of a class holds the interface at the same offset, so it only has to be found once per class
+	const UClass* Class = Object->GetClass();
+	const int32 ClassIndex = GUObjectArray.ObjectToIndex(Class);
+
+	// Serial numbers are only assigned on demand, and only once per object, so this is a plain read after the first lookup
+	int32 ClassSerialNumber = GUObjectArray.IndexToObject(ClassIndex)->GetSerialNumber();
+	if (ClassSerialNumber == 0)
+	{
+		ClassSerialNumber = GUObjectArray.AllocateSerialNumber(ClassIndex);
+	}
+
+	int32 Offset = INDEX_NONE;
+	if (!InterfaceOffsetCache.Find(ClassIndex, ClassSerialNumber, Offset))
+	{
+		const void* InterfaceAddress = const_cast<UObject*>(Object)->GetInterfaceAddress(UServiceLocatorInterface::StaticClass());
+		Offset = (InterfaceAddress != nullptr) ? int32((const uint8*)InterfaceAddress - (const uint8*)Object) : INDEX_NONE;
+
+		InterfaceOffsetCache.Add(ClassIndex, ClassSerialNumber, Offset);
+	}
+
+	return Offset;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorContainerRegistry::AttachContainer(const UObject* Owner, UServiceLocatorContainer* Container)
+{
+	using namespace ServiceLocatorContainerRegistry_Private;
+
+	if ((Owner == nullptr) || (Container == nullptr))
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("FServiceLocatorContainerRegistry::AttachContainer: Unable to attach container '%s' to object '%s'"),
+			*GetNameSafe(Container), *GetNameSafe(Owner));
+		return;
+	}
+
+	AttachedContainerAnnotations.AddAnnotation(Owner, FAttachedContainerAnnotation{ Container });
+	bAnyContainersAttached = true;
+
+	InvalidateResolvedContainers();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorContainerRegistry::DetachContainer(const UObject* Owner, UServiceLocatorContainer* Container)
+{
+	using namespace ServiceLocatorContainerRegistry_Private;
+
+	if ((Owner == nullptr) || (AttachedContainerAnnotations.GetAnnotation(Owner).Container.Get() != Container))
+	{
+		return;
+	}
+
+	AttachedContainerAnnotations.RemoveAnnotation(Owner);
+
+	InvalidateResolvedContainers();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+UServiceLocatorContainer* FServiceLocatorContainerRegistry::FindAttachedContainer(const UObject* Owner)
+{
+	using namespace ServiceLocatorContainerRegistry_Private;
+
+	if (!bAnyContainersAttached || (Owner == nullptr))
+	{
+		return nullptr;
+	}
+
+	return AttachedContainerAnnotations.GetAnnotation(Owner).Container.Get();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+uint32 FServiceLocatorContainerRegistry::GetContainersGeneration()
+{
+	using namespace ServiceLocatorContainerRegistry_Private;
+
+	return ContainersGeneration.Load(EMemoryOrder::Relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorContainerRegistry::InvalidateResolvedContainers()
+{
+	using namespace ServiceLocatorContainerRegistry_Private;
+
+	++ContainersGeneration;
+}
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorDiagnostics.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocator
+#include "ServiceLocatorDiagnostics.h"
+#include "ServiceLocatorContainer.h"
+
+// Engine
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/UniquePtr.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorDiagnostics_Private
+{
+
+	TAutoConsoleVariable<float> CVarSummaryInterval(
+		TEXT("ServiceLocator.Diagnostics.SummaryInterval"),
+		30.0f,
+		TEXT("The minimum time, in seconds, between summaries of repeated service lookup failures. 0 disables summaries."));
+
+	FCriticalSection SitesCriticalSection;
+	FServiceLookupFailureSite* FirstSite = nullptr;
+
+	// Identifies the site of a caller of a parent site. File compares by contents, as each translation unit may have its own copy of it.
+	struct FCallerSiteKey
+	{
+		const FServiceLookupFailureSite*	ParentSite;
+		const ANSICHAR*						File;
+		int32								Line;
+
+		FORCEINLINE bool operator==(const FCallerSiteKey& Other) const
+		{
+			return (ParentSite == Other.ParentSite) && (Line == Other.Line) && (FCStringAnsi::Strcmp(File, Other.File) == 0);
+		}
+
+		friend FORCEINLINE uint32 GetTypeHash(const FCallerSiteKey& Key)
+		{
+			return HashCombine(HashCombine(PointerHash(Key.ParentSite), ::GetTypeHash(Key.Line)), FCrc::StrCrc32(Key.File));
+		}
+	};
+
+	// Keys point at the file names copied into their sites, so stay valid after the module which called them is unloaded
+	TMap<FCallerSiteKey, TUniquePtr<FServiceLookupFailureSite>> CallerSites;
+
+	FDelegateHandle TickerHandle;
+	double LastSummaryTime = 0.0;
+
+	FString GetSiteLabel(const FServiceLookupFailureSite& Site, const TCHAR* CallSite, const UClass* ServiceClass)
+	{
+		const FString FunctionLabel = (ServiceClass != nullptr) ? FString::Printf(TEXT("%s<%s>"), CallSite, *ServiceClass->GetName()) : FString(CallSite);
+		return FunctionLabel + Site.GetCallerLabel();
+	}
+
+	bool Tick(float DeltaTime)
+	{
+		const float SummaryInterval = CVarSummaryInterval.GetValueOnGameThread();
+		if (SummaryInterval <= 0.0f)
+			return true;
+
+		const double CurrentTime = FPlatformTime::Seconds();
+		if ((CurrentTime - LastSummaryTime) < SummaryInterval)
+			return true;
+
+		LastSummaryTime = CurrentTime;
+		FServiceLocatorDiagnostics::LogSummary();
+		return true;
+	}
+
+} // namespace ServiceLocatorDiagnostics_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+FServiceLookupFailureSite::FServiceLookupFailureSite(const TCHAR* InCallSite, const TCHAR* InReason)
+	: CallSite(InCallSite)
+	, Reason(InReason)
+{
+	FServiceLocatorDiagnostics::RegisterSite(this);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+FServiceLookupFailureSite::FServiceLookupFailureSite(const FServiceLookupFailureSite& InParentSite, const FServiceLookupCaller& InCaller)
+	: CallSite(InParentSite.CallSite)
+	, Reason(InParentSite.Reason)
+	, ParentSite(&InParentSite)
+	, CallerLine(InCaller.Line)
+{
+	CallerFile.Append(InCaller.File, FCStringAnsi::Strlen(InCaller.File) + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+FServiceLookupFailureSite::~FServiceLookupFailureSite()
+{
+	// Sites in a module which is unloaded are destroyed with it, so mustn't be left in the list. Caller sites are owned by
+	// FServiceLocatorDiagnostics, which unregisters them itself.
+	if (ParentSite == nullptr)
+	{
+		FServiceLocatorDiagnostics::UnregisterSite(this);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+FString FServiceLookupFailureSite::GetCallerLabel() const
+{
+	if (CallerFile.Num() == 0)
+		return FString();
+
+	return FString::Printf(TEXT(" (called from %s:%d)"), *FPaths::GetCleanFilename(ANSI_TO_TCHAR(CallerFile.GetData())), CallerLine);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+FServiceLookupFailureSite& FServiceLookupFailureSite::FindOrAddCallerSite(const FServiceLookupCaller& Caller)
+{
+	return FServiceLocatorDiagnostics::FindOrAddCallerSite(this, Caller);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorDiagnostics::Startup()
+{
+	using namespace ServiceLocatorDiagnostics_Private;
+
+	LastSummaryTime = FPlatformTime::Seconds();
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&ServiceLocatorDiagnostics_Private::Tick), 1.0f);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorDiagnostics::Shutdown()
+{
+	using namespace ServiceLocatorDiagnostics_Private;
+
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorDiagnostics::RegisterSite(FServiceLookupFailureSite* Site)
+{
+	using namespace ServiceLocatorDiagnostics_Private;
+
+	FScopeLock ScopeLock(&SitesCriticalSection);
+
+	Site->NextSite = FirstSite;
+	FirstSite = Site;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorDiagnostics::UnregisterSite(FServiceLookupFailureSite* Site)
+{
+	using namespace ServiceLocatorDiagnostics_Private;
+
+	FScopeLock ScopeLock(&SitesCriticalSection);
+
+	// The sites of the site's callers share its call site and reason strings, so go with it
+	for (FServiceLookupFailureSite** SiteLink = &FirstSite; *SiteLink != nullptr;)
+	{
+		FServiceLookupFailureSite* LinkedSite = *SiteLink;
+		if ((LinkedSite == Site) || (LinkedSite->ParentSite == Site))
+		{
+			*SiteLink = LinkedSite->NextSite;
+			LinkedSite->NextSite = nullptr;
+		}
+		else
+		{
+			SiteLink = &LinkedSite->NextSite;
+		}
+	}
+
+	for (auto CallerSiteIt = CallerSites.CreateIterator(); CallerSiteIt; ++CallerSiteIt)
+	{
+		if (CallerSiteIt.Key().ParentSite == Site)
+		{
+			CallerSiteIt.RemoveCurrent();
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+FServiceLookupFailureSite& FServiceLocatorDiagnostics::FindOrAddCallerSite(const FServiceLookupFailureSite* ParentSite, const FServiceLookupCaller& Caller)
+{
+	using namespace ServiceLocatorDiagnostics_Private;
+
+	FScopeLock ScopeLock(&SitesCriticalSection);
+
+	if (const TUniquePtr<FServiceLookupFailureSite>* ExistingSite = CallerSites.Find(FCallerSiteKey{ ParentSite, Caller.File, Caller.Line }))
+	{
+		return **ExistingSite;
+	}
+
+	TUniquePtr<FServiceLookupFailureSite> CallerSite = MakeUnique<FServiceLookupFailureSite>(*ParentSite, Caller);
+	FServiceLookupFailureSite& CallerSiteRef = *CallerSite;
+
+	CallerSiteRef.NextSite = FirstSite;
+	FirstSite = &CallerSiteRef;
+
+	CallerSites.Add(FCallerSiteKey{ ParentSite, CallerSiteRef.CallerFile.GetData(), CallerSiteRef.CallerLine }, MoveTemp(CallerSite));
+	return CallerSiteRef;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorDiagnostics::LogSummary()
+{
+	using namespace ServiceLocatorDiagnostics_Private;
+
+	FScopeLock ScopeLock(&SitesCriticalSection);
+
+	for (FServiceLookupFailureSite* Site = FirstSite; Site != nullptr; Site = Site->NextSite)
+	{
+		const int32 Count = Site->Count;
+		if (Count <= Site->ReportedCount)
+			continue;
+
+		// The first failure has already been logged in full
+		const int32 NewFailures = Count - FMath::Max(Site->ReportedCount, 1);
+		Site->ReportedCount = Count;
+
+		if (NewFailures <= 0)
+			continue;
+
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("%s: %s (%d more times, %d in total)"),
+			*GetSiteLabel(*Site, Site->CallSite, Site->ServiceClass), Site->Reason, NewFailures, Count);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorDiagnostics::DumpCounters()
+{
+	using namespace ServiceLocatorDiagnostics_Private;
+
+	FScopeLock ScopeLock(&SitesCriticalSection);
+
+	int32 TotalCount = 0;
+	for (FServiceLookupFailureSite* Site = FirstSite; Site != nullptr; Site = Site->NextSite)
+	{
+		const int32 Count = Site->Count;
+		if (Count == 0)
+			continue;
+
+		UE_LOG(LogUnrealServiceLocator, Display, TEXT("%6d  %s: %s"), Count, *GetSiteLabel(*Site, Site->CallSite, Site->ServiceClass), Site->Reason);
+		TotalCount += Count;
+	}
+
+	UE_LOG(LogUnrealServiceLocator, Display, TEXT("%d service lookup failures in total"), TotalCount);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorDiagnostics::ResetCounters()
+{
+	using namespace ServiceLocatorDiagnostics_Private;
+
+	FScopeLock ScopeLock(&SitesCriticalSection);
+
+	for (FServiceLookupFailureSite* Site = FirstSite; Site != nullptr; Site = Site->NextSite)
+	{
+		FPlatformAtomics::InterlockedExchange(&Site->Count, 0);
+		Site->ReportedCount = 0;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommand ServiceLocatorDiagnosticsDumpCommand(
+	TEXT("ServiceLocator.Diagnostics.Dump"),
+	TEXT("Logs the number of service lookup failures recorded at each call site and service type"),
+	FConsoleCommandDelegate::CreateStatic(&FServiceLocatorDiagnostics::DumpCounters));
+
+static FAutoConsoleCommand ServiceLocatorDiagnosticsResetCommand(
+	TEXT("ServiceLocator.Diagnostics.Reset"),
+	TEXT("Resets the service lookup failure counters, so that the next failure at each call site is logged in full"),
+	FConsoleCommandDelegate::CreateStatic(&FServiceLocatorDiagnostics::ResetCounters));
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorEventBus.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocator
+#include "ServiceLocatorEventBus.h"
+
+// Engine
+#include "Async/ParallelFor.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceEventBus::Dispatch()
+{
+	check(IsInGameThread());
+
+	NumPendingEvents.Reset();
+
+	TArray<FChannelPtr, TInlineAllocator<16>> ParallelChannels;
+	TArray<FChannelPtr, TInlineAllocator<16>> GameThreadChannels;
+
+	// Channels are gathered up front, so that handlers can publish event types which don't have a channel yet,
+	// and referenced, so that they outlive a handler resetting the bus
+	{
+		FReadScopeLock ReadScopeLock(ChannelsLock);
+
+		for (const TPair<const UScriptStruct*, FChannelPtr>& Channel : Channels)
+		{
+			TArray<FChannelPtr, TInlineAllocator<16>>& TargetChannels = Channel.Value->bDispatchInParallel ? ParallelChannels : GameThreadChannels;
+			TargetChannels.Add(Channel.Value);
+		}
+	}
+
+	if (ParallelChannels.Num() > 0)
+	{
+		ParallelFor(ParallelChannels.Num(), [&ParallelChannels](int32 ChannelIndex)
+		{
+			ParallelChannels[ChannelIndex]->Dispatch();
+		});
+	}
+
+	for (const FChannelPtr& Channel : GameThreadChannels)
+	{
+		Channel->Dispatch();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceEventBus::Reset()
+{
+	check(IsInGameThread());
+
+	FWriteScopeLock WriteScopeLock(ChannelsLock);
+
+	Channels.Reset();
+	NumPendingEvents.Reset();
+}
+
+///////////////////////////////////////////////////////////////////////////
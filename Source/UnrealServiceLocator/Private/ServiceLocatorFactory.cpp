@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorFactory.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocator
+#include "ServiceLocatorFactory.h"
+#include "ServiceLocatorContainer.h"
+#include "ServiceLocatorTypes.h"
+#include "ServicePoolInterface.h"
+
+// Engine
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorFactory_Private
+{
+
+	const ERenameFlags PooledRenameFlags = REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_DoNotDirty | REN_NonTransactional;
+
+} // namespace ServiceLocatorFactory_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+UObject* UPooledServiceFactory::CreateService(UServiceLocatorContainer* Container, const FServiceDescriptor& ServiceDescriptor)
+{
+	UClass* ServiceType = ServiceDescriptor.GetServiceType();
+	if (ServiceType->IsChildOf<AActor>() || ServiceType->IsChildOf<UActorComponent>())
+	{
+		UE_LOG(LogUnrealServiceLocator, Error, TEXT("UPooledServiceFactory::CreateService: Factory '%s' can only pool object services, but ServiceType is '%s'"),
+			*GetNameSafe(this), *GetNameSafe(ServiceType));
+		return nullptr;
+	}
+
+	// Without an explicit reset, a reused instance would silently keep the state of its previous use
+	if (!ServiceType->ImplementsInterface(UServicePoolInterface::StaticClass()))
+	{
+		UE_LOG(LogUnrealServiceLocator, Error, TEXT("UPooledServiceFactory::CreateService: Factory '%s' can only pool services which implement IServicePoolInterface, but ServiceType '%s' doesn't"),
+			*GetNameSafe(this), *GetNameSafe(ServiceType));
+		return nullptr;
+	}
+
+	UObject* NewOuter = Container->GetOuter();
+
+	UWorld* World = Container->GetWorld();
+	UPooledServiceSubsystem* PoolSubsystem = (World != nullptr) ? World->GetSubsystem<UPooledServiceSubsystem>() : nullptr;
+	if (PoolSubsystem != nullptr)
+	{
+		if (UObject* ServiceInstance = PoolSubsystem->TakeInstance(this, ServiceType, NewOuter))
+		{
+			return ServiceInstance;
+		}
+	}
+
+	return NewObject<UObject>(NewOuter, ServiceType, NAME_None, RF_Transient);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+bool UPooledServiceFactory::DestroyService(UServiceLocatorContainer* Container, UObject* ServiceInstance)
+{
+	// Containers outside of a world have nowhere to pool their services, so they're destroyed as normal
+	UWorld* World = Container->GetWorld();
+	UPooledServiceSubsystem* PoolSubsystem = (World != nullptr) ? World->GetSubsystem<UPooledServiceSubsystem>() : nullptr;
+	return (PoolSubsystem != nullptr) && PoolSubsystem->ReleaseInstance(this, ServiceInstance, MaxPooledInstances);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+UObject* UPooledServiceSubsystem::TakeInstance(UPooledServiceFactory* Factory, UClass* ServiceType, UObject* NewOuter)
+{
+	FPooledServiceInstances* Pool = Pools.Find(Factory);
+	if (Pool == nullptr)
+	{
+		return nullptr;
+	}
+
+	while (Pool->Instances.Num() > 0)
+	{
+		UObject* ServiceInstance = Pool->Instances.Pop(false);
+		if (!IsValid(ServiceInstance) || (ServiceInstance->GetClass() != ServiceType))
+		{
+			continue;
+		}
+
+		ServiceInstance->Rename(*MakeUniqueObjectName(NewOuter, ServiceType).ToString(), NewOuter, ServiceLocatorFactory_Private::PooledRenameFlags);
+		CastChecked<IServicePoolInterface>(ServiceInstance)->ReuseFromPool();
+		return ServiceInstance;
+	}
+
+	return nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+bool UPooledServiceSubsystem::ReleaseInstance(UPooledServiceFactory* Factory, UObject* ServiceInstance, int32 MaxPooledInstances)
+{
+	IServicePoolInterface* PoolInterface = Cast<IServicePoolInterface>(ServiceInstance);
+	if (PoolInterface == nullptr)
+	{
+		return false;
+	}
+
+	FPooledServiceInstances& Pool = Pools.FindOrAdd(Factory);
+	if (Pool.Instances.Num() >= MaxPooledInstances)
+	{
+		return false;
+	}
+
+	// Reset before pooling, so that the instance doesn't keep anything from its previous use alive while it's pooled
+	PoolInterface->ReleaseToPool();
+	ServiceInstance->Rename(*MakeUniqueObjectName(this, ServiceInstance->GetClass()).ToString(), this, ServiceLocatorFactory_Private::PooledRenameFlags);
+
+	Pool.Instances.Emplace(ServiceInstance);
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void UPooledServiceSubsystem::Deinitialize()
+{
+	// Pooled instances are outered to this subsystem, so they're collected along with the world
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorInjection.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocator
+#include "ServiceLocatorInjection.h"
+#include "ServiceLocatorContainer.h"
+
+// Engine
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectAnnotation.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+const FName FServiceLocatorInjection::InjectServiceMetaData(TEXT("InjectService"));
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorInjection_Private
+{
+
+	struct FInjectionPointsAnnotation
+	{
+		TSharedPtr<const FServiceInjectionPoints> InjectionPoints;
+
+		FORCEINLINE bool IsDefault() const
+		{
+			return !InjectionPoints.IsValid();
+		}
+	};
+
+	static FUObjectAnnotationDense<FInjectionPointsAnnotation, true> InjectionPointsAnnotations;
+
+	struct FRegisteredInjectedProperty
+	{
+		FName PropertyName;
+		FName ServiceKey;
+	};
+
+	// Keyed by class path, as native classes may not be registered yet when their properties are
+	static TMap<FString, TArray<FRegisteredInjectedProperty>> RegisteredInjectedProperties;
+
+	bool IsInjectedProperty(const FProperty* Property, FName& OutServiceKey)
+	{
+#if WITH_METADATA
+		if (Property->HasMetaData(FServiceLocatorInjection::InjectServiceMetaData))
+		{
+			OutServiceKey = FName(*Property->GetMetaData(FServiceLocatorInjection::InjectServiceMetaData));
+			return true;
+		}
+#endif
+
+		if (RegisteredInjectedProperties.Num() == 0)
+		{
+			return false;
+		}
+
+		const TArray<FRegisteredInjectedProperty>* ClassProperties = RegisteredInjectedProperties.Find(Property->GetOwnerClass()->GetPathName());
+		if (ClassProperties == nullptr)
+		{
+			return false;
+		}
+
+		const FRegisteredInjectedProperty* RegisteredProperty = ClassProperties->FindByPredicate([Property](const FRegisteredInjectedProperty& Registered) { return Registered.PropertyName == Property->GetFName(); });
+		if (RegisteredProperty == nullptr)
+		{
+			return false;
+		}
+
+		OutServiceKey = RegisteredProperty->ServiceKey;
+		return true;
+	}
+
+} // namespace ServiceLocatorInjection_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+const FServiceInjectionPoints& FServiceLocatorInjection::GetInjectionPoints(const UClass* Class)
+{
+	using namespace ServiceLocatorInjection_Private;
+
+	check(IsInGameThread());
+	check(Class != nullptr);
+
+	const FInjectionPointsAnnotation& Annotation = InjectionPointsAnnotations.GetAnnotationRef(Class);
+	if (!Annotation.IsDefault())
+	{
+		return *Annotation.InjectionPoints;
+	}
+
+	TSharedRef<FServiceInjectionPoints> InjectionPoints = MakeShared<FServiceInjectionPoints>();
+	FindInjectionPoints(Class, *InjectionPoints);
+
+	InjectionPointsAnnotations.AddAnnotation(Class, FInjectionPointsAnnotation{ InjectionPoints });
+	return *InjectionPointsAnnotations.GetAnnotationRef(Class).InjectionPoints;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorInjection::FindInjectionPoints(const UClass* Class, FServiceInjectionPoints& OutInjectionPoints)
+{
+	using namespace ServiceLocatorInjection_Private;
+
+	check(IsInGameThread());
+	check(Class != nullptr);
+
+	for (TFieldIterator<FProperty> PropertyIt(Class); PropertyIt; ++PropertyIt)
+	{
+		const FProperty* Property = *PropertyIt;
+
+		FName ServiceKey;
+		if (!IsInjectedProperty(Property, ServiceKey))
+		{
+			continue;
+		}
+
+		FServiceInjectionPoint InjectionPoint;
+		InjectionPoint.Offset = Property->GetOffset_ForInternal();
+		InjectionPoint.ServiceKey = ServiceKey;
+
+		// Class properties are object properties too, but hold a type rather than an instance
+		const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property);
+		const FInterfaceProperty* InterfaceProperty = CastField<FInterfaceProperty>(Property);
+		if ((ObjectProperty != nullptr) && !Property->IsA<FClassProperty>())
+		{
+			InjectionPoint.ServiceType = ObjectProperty->PropertyClass;
+		}
+		else if (InterfaceProperty != nullptr)
+		{
+			InjectionPoint.ServiceType = InterfaceProperty->InterfaceClass;
+			InjectionPoint.bInterface = true;
+		}
+
+		if ((InjectionPoint.ServiceType == nullptr) || (Property->ArrayDim != 1))
+		{
+			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("FServiceLocatorInjection::FindInjectionPoints: Property '%s' of class '%s' is marked for injection, but isn't a single UObject pointer or TScriptInterface"),
+				*Property->GetName(), *GetNameSafe(Class));
+			continue;
+		}
+
+		OutInjectionPoints.Emplace(InjectionPoint);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorInjection::RegisterInjectedProperty(const FString& ClassPath, FName PropertyName, FName ServiceKey)
+{
+	using namespace ServiceLocatorInjection_Private;
+
+	check(IsInGameThread());
+
+	RegisteredInjectedProperties.FindOrAdd(ClassPath).Add(FRegisteredInjectedProperty{ PropertyName, ServiceKey });
+
+	// Child classes inherit the property, so every cached class may be affected
+	Reset();
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorInjection::Reset()
+{
+	using namespace ServiceLocatorInjection_Private;
+
+	check(IsInGameThread());
+
+	InjectionPointsAnnotations.RemoveAllAnnotations();
+}
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,252 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorNativeRegistry.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocator
+#include "ServiceLocatorNativeRegistry.h"
+#include "ServiceLocatorConfig.h"
+#include "ServiceLocatorContainer.h"
+#include "ServiceLocatorFactory.h"
+#include "ServiceLocatorTypes.h"
+
+// Engine
+#include "UObject/Package.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorNativeRegistry_Private
+{
+
+	struct FPendingRegistration
+	{
+		const TCHAR*													Group;
+		FServiceLocatorNativeRegistry::FGetServiceTypeFunction			GetServiceType;
+		FServiceLocatorNativeRegistry::FConfigureDescriptorFunction		ConfigureDescriptor;
+	};
+
+	// Function local, as registrations are recorded during static initialisation, in no particular order
+	TArray<FPendingRegistration>& GetPendingRegistrations()
+	{
+		static TArray<FPendingRegistration> PendingRegistrations;
+		return PendingRegistrations;
+	}
+
+	struct FNativeService
+	{
+		FName				Group;
+
+		// The descriptor's factory, if any, is a rooted template, duplicated into each merged config
+		FServiceDescriptor	Descriptor;
+	};
+
+	static TArray<FNativeService> NativeServices;
+
+	struct FMergedConfig
+	{
+		TWeakObjectPtr<UServiceLocatorConfig>	SourceConfig;
+		bool									bHasSourceConfig	= false;
+		TArray<FName>							Groups;
+		TWeakObjectPtr<UServiceLocatorConfig>	MergedConfig;
+		uint32									Generation			= 0;
+	};
+
+	// There are only ever a handful of distinct configs and groups, so a linear scan beats hashing
+	static TArray<FMergedConfig> MergedConfigs;
+
+	// Bumped whenever a native service is added or a config is edited, so that stale merged configs are rebuilt
+	static uint32 Generation = 1;
+
+	bool IsSameDescriptor(const FServiceDescriptor& A, const FServiceDescriptor& B)
+	{
+		return (A.ServiceType == B.ServiceType) && (A.GetServiceKey() == B.GetServiceKey());
+	}
+
+} // namespace ServiceLocatorNativeRegistry_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorNativeRegistry::RegisterService(const TCHAR* Group, FGetServiceTypeFunction GetServiceType, FConfigureDescriptorFunction ConfigureDescriptor)
+{
+	using namespace ServiceLocatorNativeRegistry_Private;
+
+	GetPendingRegistrations().Emplace(FPendingRegistration{ Group, GetServiceType, ConfigureDescriptor });
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorNativeRegistry::ProcessPendingRegistrations()
+{
+	using namespace ServiceLocatorNativeRegistry_Private;
+
+	check(IsInGameThread());
+
+	TArray<FPendingRegistration>& PendingRegistrations = GetPendingRegistrations();
+	if (PendingRegistrations.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FPendingRegistration> RegistrationsToProcess = MoveTemp(PendingRegistrations);
+
+	TArray<FServiceDescriptor> Descriptors;
+	Descriptors.Reserve(RegistrationsToProcess.Num());
+
+	for (const FPendingRegistration& Registration : RegistrationsToProcess)
+	{
+		FServiceDescriptor& Descriptor = Descriptors.AddDefaulted_GetRef();
+		Descriptor.ServiceType = Registration.GetServiceType();
+
+		if (Registration.ConfigureDescriptor != nullptr)
+		{
+			Registration.ConfigureDescriptor(Descriptor);
+		}
+
+		if (Descriptor.MappedTypes.Num() == 0)
+		{
+			Descriptor.MappedTypes.Emplace(Descriptor.ServiceType);
+		}
+	}
+
+	// Native services are validated as soon as they're resolved, rather than whenever a container locates them
+	FServiceConfigValidation Validation;
+	UServiceLocatorConfig::ValidateDescriptors(Descriptors, Validation);
+
+	TBitArray<> InvalidDescriptors(false, Descriptors.Num());
+	for (const FServiceConfigValidationIssue& Issue : Validation.Issues)
+	{
+		if (Issue.bError)
+		{
+			UE_LOG(LogUnrealServiceLocator, Error, TEXT("FServiceLocatorNativeRegistry::ProcessPendingRegistrations: Native service '%s' in group '%s' won't be located: %s"),
+				*Descriptors[Issue.DescriptorIndex].ServiceType.ToString(), RegistrationsToProcess[Issue.DescriptorIndex].Group, *Issue.Message);
+			InvalidDescriptors[Issue.DescriptorIndex] = true;
+		}
+		else
+		{
+			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("FServiceLocatorNativeRegistry::ProcessPendingRegistrations: Native service '%s' in group '%s': %s"),
+				*Descriptors[Issue.DescriptorIndex].ServiceType.ToString(), RegistrationsToProcess[Issue.DescriptorIndex].Group, *Issue.Message);
+		}
+	}
+
+	for (int32 DescriptorIndex = 0; DescriptorIndex < Descriptors.Num(); ++DescriptorIndex)
+	{
+		if (!InvalidDescriptors[DescriptorIndex])
+		{
+			// Nothing else references the factory, as NativeServices isn't seen by GC
+			if (UServiceFactory* Factory = Descriptors[DescriptorIndex].Factory)
+			{
+				Factory->AddToRoot();
+			}
+
+			NativeServices.Emplace(FNativeService{ FName(RegistrationsToProcess[DescriptorIndex].Group), MoveTemp(Descriptors[DescriptorIndex]) });
+		}
+	}
+
+	++Generation;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+UServiceLocatorConfig* FServiceLocatorNativeRegistry::GetMergedConfig(UServiceLocatorConfig* Config, const TArray<FName>& Groups)
+{
+	using namespace ServiceLocatorNativeRegistry_Private;
+
+	check(IsInGameThread());
+
+	if (Groups.Num() == 0)
+	{
+		return Config;
+	}
+
+	ProcessPendingRegistrations();
+
+	const bool bHasSourceConfig = (Config != nullptr);
+
+	// Merged configs which have been garbage collected, or whose source config has been, are no longer needed
+	MergedConfigs.RemoveAllSwap([](const FMergedConfig& Candidate)
+	{
+		return !Candidate.MergedConfig.IsValid() || (Candidate.bHasSourceConfig && !Candidate.SourceConfig.IsValid());
+	});
+
+	FMergedConfig* MergedConfig = MergedConfigs.FindByPredicate([Config, bHasSourceConfig, &Groups](const FMergedConfig& Candidate)
+	{
+		return (Candidate.bHasSourceConfig == bHasSourceConfig) && (Candidate.SourceConfig.Get() == Config) && (Candidate.Groups == Groups);
+	});
+
+	if ((MergedConfig != nullptr) && (MergedConfig->Generation == Generation))
+	{
+		return MergedConfig->MergedConfig.Get();
+	}
+
+	TArray<FServiceDescriptor> Descriptors;
+	for (const FNativeService& NativeService : NativeServices)
+	{
+		if (!Groups.Contains(NativeService.Group))
+		{
+			continue;
+		}
+
+		// The config can replace a native service, e.g. with a Blueprint subclass, by describing the same type and key
+		const bool bReplacedByConfig = bHasSourceConfig && Config->ServiceDescriptors.ContainsByPredicate([&NativeService](const FServiceDescriptor& Descriptor)
+		{
+			return IsSameDescriptor(Descriptor, NativeService.Descriptor);
+		});
+
+		if (!bReplacedByConfig)
+		{
+			Descriptors.Emplace(NativeService.Descriptor);
+		}
+	}
+
+	if (Descriptors.Num() == 0)
+	{
+		return Config;
+	}
+
+	const int32 NumNativeDescriptors = Descriptors.Num();
+
+	if (bHasSourceConfig)
+	{
+		Descriptors.Append(Config->ServiceDescriptors);
+	}
+
+	const FName MergedConfigName = MakeUniqueObjectName(GetTransientPackage(), UServiceLocatorConfig::StaticClass(),
+		bHasSourceConfig ? FName(*FString::Printf(TEXT("%s_Native"), *Config->GetName())) : FName(TEXT("NativeServiceLocatorConfig")));
+
+	// Kept alive by the containers using it, so that it's only rebuilt once every container has moved on from it
+	UServiceLocatorConfig* NewMergedConfig = NewObject<UServiceLocatorConfig>(GetTransientPackage(), MergedConfigName, RF_Transient);
+	NewMergedConfig->ServiceDescriptors = MoveTemp(Descriptors);
+
+	// Factories may hold state, e.g. pooled instances, so each merged config gets its own rather than sharing the template
+	for (int32 DescriptorIndex = 0; DescriptorIndex < NumNativeDescriptors; ++DescriptorIndex)
+	{
+		UServiceFactory*& Factory = NewMergedConfig->ServiceDescriptors[DescriptorIndex].Factory;
+		if (Factory != nullptr)
+		{
+			Factory = DuplicateObject<UServiceFactory>(Factory, NewMergedConfig);
+		}
+	}
+
+	if (MergedConfig == nullptr)
+	{
+		MergedConfig = &MergedConfigs.AddDefaulted_GetRef();
+		MergedConfig->SourceConfig = Config;
+		MergedConfig->bHasSourceConfig = bHasSourceConfig;
+		MergedConfig->Groups = Groups;
+	}
+
+	MergedConfig->MergedConfig = NewMergedConfig;
+	MergedConfig->Generation = Generation;
+
+	return NewMergedConfig;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorNativeRegistry::InvalidateMergedConfigs()
+{
+	using namespace ServiceLocatorNativeRegistry_Private;
+
+	++Generation;
+}
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorProxy.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocator
+#include "ServiceLocatorProxy.h"
+
+// Engine
+// ...
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceCallQueue::Enqueue(TUniqueFunction<void()>&& Call)
+{
+	Calls.Enqueue(MoveTemp(Call));
+
+	if (!bHasQueuedCalls.AtomicSet(true) && OnFirstCallQueued)
+	{
+		OnFirstCallQueued();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+int32 FServiceCallQueue::Drain()
+{
+	check(IsInGameThread());
+
+	// Cleared before draining, so that a call queued meanwhile is signalled again
+	bHasQueuedCalls = false;
+
+	int32 NumCalls = 0;
+
+	TUniqueFunction<void()> Call;
+	while (Calls.Dequeue(Call))
+	{
+		Call();
+		++NumCalls;
+	}
+
+	return NumCalls;
+}
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorWorldRegistry.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocator
+#include "ServiceLocatorWorldRegistry.h"
+#include "ServiceLocatorContainer.h"
+
+// Engine
+#include "Engine/World.h"
+#include "UObject/UObjectAnnotation.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorWorldRegistry_Private
+{
+
+	struct FRootContainerAnnotation
+	{
+		TWeakObjectPtr<UServiceLocatorContainer> Container;
+
+		FORCEINLINE bool IsDefault() const
+		{
+			return Container.IsExplicitlyNull();
+		}
+	};
+
+	static FUObjectAnnotationDense<FRootContainerAnnotation, true> RootContainerAnnotations;
+
+} // namespace ServiceLocatorWorldRegistry_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorWorldRegistry::RegisterRootContainer(UWorld* World, UServiceLocatorContainer* Container)
+{
+	using namespace ServiceLocatorWorldRegistry_Private;
+
+	if ((World == nullptr) || (Container == nullptr))
+	{
+		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("FServiceLocatorWorldRegistry::RegisterRootContainer: Unable to register container '%s' as the root of world '%s'"),
+			*GetNameSafe(Container), *GetNameSafe(World));
+		return;
+	}
+
+	RootContainerAnnotations.AddAnnotation(World, FRootContainerAnnotation{ Container });
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+void FServiceLocatorWorldRegistry::UnregisterRootContainer(UWorld* World, UServiceLocatorContainer* Container)
+{
+	using namespace ServiceLocatorWorldRegistry_Private;
+
+	if ((World == nullptr) || (RootContainerAnnotations.GetAnnotation(World).Container.Get() != Container))
+	{
+		return;
+	}
+
+	RootContainerAnnotations.RemoveAnnotation(World);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+UServiceLocatorContainer* FServiceLocatorWorldRegistry::GetRootContainer(const UWorld* World)
+{
+	using namespace ServiceLocatorWorldRegistry_Private;
+
+	return (World != nullptr) ? RootContainerAnnotations.GetAnnotation(World).Container.Get() : nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////
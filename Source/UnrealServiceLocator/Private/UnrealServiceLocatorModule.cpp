@@ -2,6 +2,12 @@
 
 // Engine
 #include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+// UnrealServiceLocator
+#include "ServiceLocatorClassCache.h"
+#include "ServiceLocatorDiagnostics.h"
+#include "ServiceLocatorNativeRegistry.h"
 
 class FUnrealServiceLocatorModule : public IModuleInterface
 {
@@ -9,14 +15,28 @@ public:
 
 	void StartupModule() override final
 	{
-
+		FServiceLocatorDiagnostics::Startup();
+		FServiceLocatorClassCache::Startup();
+
+		// Native services are validated as soon as the classes of the module registering them are, rather than on first use
+		CompiledInUObjectsRegisteredHandle = FCoreUObjectDelegates::CompiledInUObjectsRegisteredDelegate.AddLambda([](FName /* Package */)
+		{
+			FServiceLocatorNativeRegistry::ProcessPendingRegistrations();
+		});
 	}
 
 	void ShutdownModule() override final
 	{
+		FCoreUObjectDelegates::CompiledInUObjectsRegisteredDelegate.Remove(CompiledInUObjectsRegisteredHandle);
 
+		FServiceLocatorClassCache::Shutdown();
+		FServiceLocatorDiagnostics::Shutdown();
 	}
 
+private:
+
+	FDelegateHandle CompiledInUObjectsRegisteredHandle;
+
 };
 
 IMPLEMENT_MODULE(FUnrealServiceLocatorModule, UnrealServiceLocator)
\ No newline at end of file
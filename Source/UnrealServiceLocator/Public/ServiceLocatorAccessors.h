@@ -16,15 +16,52 @@ class IServiceLocatorInterface;
 ///////////////////////////////////////////////////////////////////////////
 
 template<typename ServiceType, typename ObjectType>
-FORCEINLINE_DEBUGGABLE static ServiceType* GetService(const ObjectType* Object)
+FORCEINLINE_DEBUGGABLE static ServiceType* GetService(const ObjectType* Object, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
 {
-	return UServiceLocatorContainer::GetService<ServiceType, ObjectType>(Object);
+	return UServiceLocatorContainer::GetService<ServiceType, ObjectType>(Object, Caller);
 }
 
 template<typename ServiceType, typename ObjectType>
-FORCEINLINE_DEBUGGABLE static ServiceType* GetService(const TWeakObjectPtr<ObjectType>& Object)
+FORCEINLINE_DEBUGGABLE static ServiceType* GetService(const TWeakObjectPtr<ObjectType>& Object, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
 {
-	return GetService(Object.Get());
+	return GetService<ServiceType>(Object.Get(), Caller);
+}
+
+template<typename ServiceType, typename ObjectType>
+FORCEINLINE_DEBUGGABLE static ServiceType* GetService(const ObjectType* Object, FName Key, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
+{
+	return UServiceLocatorContainer::GetService<ServiceType, ObjectType>(Object, Key, Caller);
+}
+
+template<typename ServiceType, typename ObjectType>
+FORCEINLINE_DEBUGGABLE static ServiceType* GetService(const ObjectType* Object, const FGameplayTag& Tag, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
+{
+	return UServiceLocatorContainer::GetService<ServiceType, ObjectType>(Object, Tag, Caller);
+}
+
+// Gets a service per object, resolving the service type once for the whole batch, see UServiceLocatorContainer::GetServices()
+template<typename ServiceType, typename ElementType>
+FORCEINLINE_DEBUGGABLE static void GetServices(TArrayView<ElementType> Objects, TArray<ServiceType*>& OutServices, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
+{
+	UServiceLocatorContainer::GetServices<ServiceType>(Objects, OutServices, Caller);
+}
+
+template<typename ServiceType, typename ElementType, typename AllocatorType>
+FORCEINLINE_DEBUGGABLE static void GetServices(const TArray<ElementType, AllocatorType>& Objects, TArray<ServiceType*>& OutServices, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
+{
+	UServiceLocatorContainer::GetServices<ServiceType>(MakeArrayView(Objects), OutServices, Caller);
+}
+
+// Fills the UPROPERTYs of Target marked with meta=(InjectService) from the container of Object, e.g. when Target is spawned
+template<typename ObjectType>
+FORCEINLINE_DEBUGGABLE static int32 InjectServices(UObject* Target, const ObjectType* Object)
+{
+	const IServiceLocatorInterface* ObjectAsSLI = (Object != nullptr) ? TGetObjectAsSLI<ObjectType>::Execute(Object) : nullptr;
+	UServiceLocatorContainer* Container = (ObjectAsSLI != nullptr) ? ObjectAsSLI->GetContainer() : TFindAttachedContainer<ObjectType>::Execute(Object);
+	if (Container == nullptr)
+		return 0;
+
+	return Container->InjectServices(Target);
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -32,32 +69,87 @@ FORCEINLINE_DEBUGGABLE static ServiceType* GetService(const TWeakObjectPtr<Objec
 namespace ServiceLocatorAccessors_Private
 {
 
-	extern UNREALSERVICELOCATOR_API const IServiceLocatorInterface* GetGameStateService_GetGameStateSLIFromWorldContextObject(const UObject* WorldContextObject);
-	extern UNREALSERVICELOCATOR_API const IServiceLocatorInterface* GetGameModeService_GetGameModeSLIFromWorldContextObject(const UObject* WorldContextObject);
+	extern UNREALSERVICELOCATOR_API const IServiceLocatorInterface* GetGameStateService_GetGameStateSLIFromWorldContextObject(const UObject* WorldContextObject, const FServiceLookupCaller& Caller);
+	extern UNREALSERVICELOCATOR_API const IServiceLocatorInterface* GetGameModeService_GetGameModeSLIFromWorldContextObject(const UObject* WorldContextObject, const FServiceLookupCaller& Caller);
+
+	extern UNREALSERVICELOCATOR_API UServiceLocatorContainer* GetWorldService_GetRootContainerFromWorldContextObject(const UObject* WorldContextObject, const FServiceLookupCaller& Caller);
+
+	extern UNREALSERVICELOCATOR_API UServiceLocatorContainer* GetPlayerStateService_GetPlayerStateContainerFromPlayerContextObject(const UObject* PlayerContextObject, const FServiceLookupCaller& Caller);
+	extern UNREALSERVICELOCATOR_API UServiceLocatorContainer* GetPlayerControllerService_GetPlayerControllerContainerFromPlayerContextObject(const UObject* PlayerContextObject, const FServiceLookupCaller& Caller);
+	extern UNREALSERVICELOCATOR_API UServiceLocatorContainer* GetLocalPlayerService_GetLocalPlayerContainerFromPlayerContextObject(const UObject* PlayerContextObject, const FServiceLookupCaller& Caller);
 
 } // namespace ServiceLocatorAccessors_Private
 
 ///////////////////////////////////////////////////////////////////////////
 
 template<typename ServiceType>
-FORCEINLINE_DEBUGGABLE static ServiceType* GetGameStateService(const UObject* WorldContextObject)
+FORCEINLINE_DEBUGGABLE static ServiceType* GetGameStateService(const UObject* WorldContextObject, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
 {
-	const IServiceLocatorInterface* ServiceLocatorInterface = ServiceLocatorAccessors_Private::GetGameStateService_GetGameStateSLIFromWorldContextObject(WorldContextObject);
+	const IServiceLocatorInterface* ServiceLocatorInterface = ServiceLocatorAccessors_Private::GetGameStateService_GetGameStateSLIFromWorldContextObject(WorldContextObject, Caller);
 	if (ServiceLocatorInterface == nullptr)
 		return nullptr;
 
-	return UServiceLocatorContainer::GetService<ServiceType>(ServiceLocatorInterface);
+	return UServiceLocatorContainer::GetService<ServiceType>(ServiceLocatorInterface, Caller);
 }
 
 template<typename ServiceType>
-FORCEINLINE_DEBUGGABLE static ServiceType* GetGameModeService(const UObject* WorldContextObject)
+FORCEINLINE_DEBUGGABLE static ServiceType* GetGameModeService(const UObject* WorldContextObject, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
 {
-	const IServiceLocatorInterface* ServiceLocatorInterface = ServiceLocatorAccessors_Private::GetGameModeService_GetGameModeSLIFromWorldContextObject(WorldContextObject);
+	const IServiceLocatorInterface* ServiceLocatorInterface = ServiceLocatorAccessors_Private::GetGameModeService_GetGameModeSLIFromWorldContextObject(WorldContextObject, Caller);
 	if (ServiceLocatorInterface == nullptr)
 		return nullptr;
 
-	return UServiceLocatorContainer::GetService<ServiceType>(ServiceLocatorInterface);
+	return UServiceLocatorContainer::GetService<ServiceType>(ServiceLocatorInterface, Caller);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+// Gets a service from the root container registered for the context object's world with FServiceLocatorWorldRegistry
+template<typename ServiceType>
+FORCEINLINE_DEBUGGABLE static ServiceType* GetWorldService(const UObject* WorldContextObject, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
+{
+	UServiceLocatorContainer* Container = ServiceLocatorAccessors_Private::GetWorldService_GetRootContainerFromWorldContextObject(WorldContextObject, Caller);
+	if (Container == nullptr)
+		return nullptr;
+
+	return Container->GetService<ServiceType>();
 }
 
 ///////////////////////////////////////////////////////////////////////////
 
+// The player accessors take a player context object, which can be the player's APlayerState, APlayerController, ULocalPlayer
+// or possessed APawn. The container of each player object is cached on the object when it's resolved, until a container is
+// created, destroyed, attached or detached. Call FServiceLocatorContainerRegistry::InvalidateResolvedContainers() if a player
+// object's GetContainer() switches to another existing container.
+
+template<typename ServiceType>
+FORCEINLINE_DEBUGGABLE static ServiceType* GetPlayerStateService(const UObject* PlayerContextObject, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
+{
+	UServiceLocatorContainer* Container = ServiceLocatorAccessors_Private::GetPlayerStateService_GetPlayerStateContainerFromPlayerContextObject(PlayerContextObject, Caller);
+	if (Container == nullptr)
+		return nullptr;
+
+	return Container->GetService<ServiceType>();
+}
+
+template<typename ServiceType>
+FORCEINLINE_DEBUGGABLE static ServiceType* GetPlayerControllerService(const UObject* PlayerContextObject, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
+{
+	UServiceLocatorContainer* Container = ServiceLocatorAccessors_Private::GetPlayerControllerService_GetPlayerControllerContainerFromPlayerContextObject(PlayerContextObject, Caller);
+	if (Container == nullptr)
+		return nullptr;
+
+	return Container->GetService<ServiceType>();
+}
+
+template<typename ServiceType>
+FORCEINLINE_DEBUGGABLE static ServiceType* GetLocalPlayerService(const UObject* PlayerContextObject, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER)
+{
+	UServiceLocatorContainer* Container = ServiceLocatorAccessors_Private::GetLocalPlayerService_GetLocalPlayerContainerFromPlayerContextObject(PlayerContextObject, Caller);
+	if (Container == nullptr)
+		return nullptr;
+
+	return Container->GetService<ServiceType>();
+}
+
+///////////////////////////////////////////////////////////////////////////
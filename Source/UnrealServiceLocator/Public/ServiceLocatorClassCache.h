@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorClassCache.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+// Forward Declarations
+class UServiceLocatorConfig;
+
+///////////////////////////////////////////////////////////////////////////
+
+struct FServiceMappedTypeLayout
+{
+	// Weak, since layouts aren't referenced by GC and may outlive the class, e.g. when a blueprint is recompiled
+	TWeakObjectPtr<UClass>	MappedType;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+struct FServiceDescriptorLayout
+{
+	// Whether the descriptor's ServiceType can be located or created, i.e. it's set and isn't abstract or an interface
+	bool								bValidServiceType	= false;
+
+	// The service type the layout was validated against, if valid. Weak, so that the layout goes stale if the class is unloaded.
+	TWeakObjectPtr<UClass>				ServiceType;
+
+	// The descriptor's mapped types which the service type is compatible with, in descriptor order
+	TArray<FServiceMappedTypeLayout>	MappedTypes;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * The validated layout of a config, parallel to its ServiceDescriptors. Layouts are immutable once built.
+ */
+struct FServiceConfigLayout
+{
+	TArray<FServiceDescriptorLayout>	Descriptors;
+
+	// The number of soft service and mapped type classes which weren't loaded when the layout was built
+	int32								NumUnresolvedClasses	= 0;
+};
+
+using FServiceConfigLayoutRef = TSharedRef<const FServiceConfigLayout, ESPMode::ThreadSafe>;
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * A process-wide, thread-safe cache of validated config layouts, so that containers in every world of the process share
+ * one round of class validation per config. Layouts of destroyed configs, or referencing destroyed classes, are evicted
+ * after each garbage collection, and every layout is discarded when objects are reinstanced.
+ */
+class UNREALSERVICELOCATOR_API FServiceLocatorClassCache
+{
+public:
+
+	static void Startup();
+	static void Shutdown();
+
+	/**
+	 * Gets the layout of Config, building it if it isn't cached, Config has changed shape, or classes have loaded since it was built
+	 * @param	Config					The config to get the layout of
+	 * @return	FServiceConfigLayoutRef	The layout, which remains valid even if the cache is invalidated
+	 */
+	static FServiceConfigLayoutRef GetConfigLayout(const UServiceLocatorConfig* Config);
+
+	/**
+	 * Discards the cached layout of Config, so that it's rebuilt the next time it's needed
+	 */
+	static void Invalidate(const UServiceLocatorConfig* Config);
+
+	/**
+	 * Discards every cached layout
+	 */
+	static void Reset();
+
+	/**
+	 * Discards the cached layouts of configs which have been destroyed, or which reference a class that has been destroyed
+	 */
+	static void EvictStaleLayouts();
+
+};
+
+///////////////////////////////////////////////////////////////////////////
@@ -8,11 +8,83 @@
 #include "Engine/DataAsset.h"
 
 // UnrealServiceLocator
+#include "ServiceLocatorInjection.h"
 #include "ServiceLocatorTypes.h"
 #include "ServiceLocatorConfig.generated.h"
 
 ///////////////////////////////////////////////////////////////////////////
 
+struct FServiceConfigValidationIssue
+{
+	// The descriptor the issue was found in
+	int32	DescriptorIndex	= INDEX_NONE;
+
+	// Whether the issue stops the descriptor from being located, rather than being a likely mistake
+	bool	bError			= true;
+
+	FString	Message;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+// A type (and key) which several descriptors map, of which only the last descriptor's service remains mapped
+struct FServiceConfigDisplacement
+{
+	UClass*	MappedType					= nullptr;
+	FName	ServiceKey;
+	int32	DisplacedDescriptorIndex	= INDEX_NONE;
+	int32	DescriptorIndex				= INDEX_NONE;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+// A service injected into another service, i.e. an edge of the config's service graph
+struct FServiceConfigDependency
+{
+	int32	DescriptorIndex				= INDEX_NONE;
+	UClass*	ServiceType					= nullptr;
+	FName	ServiceKey;
+
+	// The descriptor which provides the dependency, or INDEX_NONE if it must come from elsewhere, e.g. a registered service
+	int32	DependencyDescriptorIndex	= INDEX_NONE;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+struct FServiceConfigValidation
+{
+	TArray<FServiceConfigValidationIssue>	Issues;
+	TArray<FServiceConfigDisplacement>		Displacements;
+	TArray<FServiceConfigDependency>		Dependencies;
+
+	int32 GetNumErrors() const
+	{
+		int32 NumErrors = 0;
+		for (const FServiceConfigValidationIssue& Issue : Issues)
+		{
+			NumErrors += Issue.bError ? 1 : 0;
+		}
+		return NumErrors;
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+// The classes and injection points a set of descriptors refers to, resolved on the game thread so that the descriptors can be validated on any thread
+struct FServiceDescriptorClasses
+{
+	// Per descriptor, null if the service type is unset or not loaded
+	TArray<UClass*>					ServiceTypes;
+
+	// Per descriptor, per mapped type, null if the mapped type is unset or not loaded
+	TArray<TArray<UClass*>>			MappedTypes;
+
+	// Per descriptor, the services injected into the service type, empty if it's unset or not loaded
+	TArray<FServiceInjectionPoints>	InjectionPoints;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
 UCLASS()
 class UNREALSERVICELOCATOR_API UServiceLocatorConfig : public UDataAsset
 {
@@ -25,6 +97,44 @@ public:
 	UPROPERTY(EditAnywhere)
 	TArray<FServiceDescriptor> ServiceDescriptors;
 
+	/**
+	 * Checks every descriptor without locating anything: unset, unloaded or abstract service types, incompatible mapped types,
+	 * mappings which displace each other, and the services injected into each service.
+	 * Doesn't load classes, but resolves them, so must be called on the game thread.
+	 * @param	OutValidation	Receives the issues, displacements and dependencies found
+	 */
+	void Validate(FServiceConfigValidation& OutValidation) const { ValidateDescriptors(ServiceDescriptors, OutValidation); }
+
+	/**
+	 * Resolves the classes every descriptor refers to, without loading them, along with their injection points. Must be called on the game thread.
+	 * @param	OutClasses		Receives the resolved classes and injection points
+	 */
+	void ResolveClasses(FServiceDescriptorClasses& OutClasses) const { ResolveDescriptorClasses(ServiceDescriptors, OutClasses); }
+
+	/**
+	 * Validates as above, using classes and injection points resolved by ResolveClasses(). Only works out the mappings, displacements
+	 * and dependencies from them, so may be called from any thread, for several configs at once.
+	 * @param	Classes			The classes resolved for this config, which mustn't have been edited since
+	 * @param	OutValidation	Receives the issues, displacements and dependencies found
+	 */
+	void Validate(const FServiceDescriptorClasses& Classes, FServiceConfigValidation& OutValidation) const { ValidateDescriptors(ServiceDescriptors, Classes, OutValidation); }
+
+	/**
+	 * Validates descriptors which aren't held by a config, e.g. natively registered services, as Validate() does
+	 * @param	Descriptors		The descriptors to validate, where issues refer to descriptors by their index in this view
+	 * @param	OutValidation	Receives the issues, displacements and dependencies found
+	 */
+	static void ValidateDescriptors(TArrayView<const FServiceDescriptor> Descriptors, FServiceConfigValidation& OutValidation);
+	static void ValidateDescriptors(TArrayView<const FServiceDescriptor> Descriptors, const FServiceDescriptorClasses& Classes, FServiceConfigValidation& OutValidation);
+	static void ResolveDescriptorClasses(TArrayView<const FServiceDescriptor> Descriptors, FServiceDescriptorClasses& OutClasses);
+
+#if WITH_EDITOR
+	//////////////////////////////////////////////
+	// Overridden Functions - UObject
+
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	//////////////////////////////////////////////
 
 };
@@ -5,18 +5,32 @@
 #pragma once
 
 // Engine
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/EngineTypes.h"
+#include "Templates/UniquePtr.h"
+#include "Tickable.h"
 #include "UObject/Object.h"
 
 // UnrealServiceLocator
+#include "ServiceLocatorClassCache.h"
+#include "ServiceLocatorDiagnostics.h"
+#include "ServiceLocatorEventBus.h"
 #include "ServiceLocatorHelpers.h"
+#include "ServiceLocatorProxy.h"
 #include "ServiceLocatorContainer.generated.h"
 
 // Forward Declarations
 class AActor;
 class UActorComponent;
+class ULevel;
 class UServiceLocatorConfig;
+class IServiceTickInterface;
 enum class EServiceLocationBehaviour : uint8;
+enum class EServiceState : uint8;
 struct FServiceDescriptor;
+struct FServiceSpawnSettings;
+struct FSoftObjectPath;
+struct FStreamableHandle;
 
 ///////////////////////////////////////////////////////////////////////////
 
@@ -24,6 +38,63 @@ UNREALSERVICELOCATOR_API DECLARE_LOG_CATEGORY_EXTERN(LogUnrealServiceLocator, Wa
 
 ///////////////////////////////////////////////////////////////////////////
 
+// Whether service lookups are checked against the thread affinity of their descriptor
+#ifndef SERVICE_LOCATOR_THREAD_CHECKS
+	#define SERVICE_LOCATOR_THREAD_CHECKS !UE_BUILD_SHIPPING
+#endif
+
+// Whether services can be overridden at runtime, e.g. to swap a service for a mock in a test
+#ifndef SERVICE_LOCATOR_OVERRIDES
+	#define SERVICE_LOCATOR_OVERRIDES !UE_BUILD_SHIPPING
+#endif
+
+///////////////////////////////////////////////////////////////////////////
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnServicesLocated, UServiceLocatorContainer* /* Container */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnServicesWarm, UServiceLocatorContainer* /* Container */);
+
+///////////////////////////////////////////////////////////////////////////
+
+struct FServiceShutdownTiming
+{
+	// The name of the service that was shut down
+	FName		ServiceName;
+
+	// The concrete type of the service that was shut down
+	UClass*		ServiceType		= nullptr;
+
+	// The time spent shutting down and destroying the service
+	double		Milliseconds	= 0.0;
+
+	// Whether the service was shut down on a worker thread
+	bool		bParallel		= false;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+struct FServiceTickTiming
+{
+	// The name of the ticked service
+	FName		ServiceName;
+
+	// The concrete type of the ticked service
+	UClass*		ServiceType			= nullptr;
+
+	// The time spent in the service's last tick
+	double		LastMilliseconds	= 0.0;
+
+	// The longest time spent in a single tick of the service
+	double		PeakMilliseconds	= 0.0;
+
+	// The number of ticks which took longer than the service's budget
+	int32		NumOverruns			= 0;
+
+	// Whether the service ticks on worker threads
+	bool		bParallel			= false;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
 UCLASS(DefaultToInstanced)
 class UNREALSERVICELOCATOR_API UServiceLocatorContainer : public UObject
 {
@@ -40,19 +111,142 @@ public:
 	/**
 	 * Returns an instance of the service specified by the ServiceType template parameter
 	 * @param	Object			The object to find the service locator container in
+	 * @param	Caller			Where the lookup is made from, which its failures are counted against (see FServiceLookupFailureSite)
+	 * @return	ServiceType*	The service instance
+	 */
+	template<typename ServiceType, typename ObjectType>
+	FORCEINLINE static ServiceType* GetService(const ObjectType* Object, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER);
+
+	/**
+	 * Returns the instance of the service specified by the ServiceType template parameter which is mapped under Key
+	 * @param	Object			The object to find the service locator container in
+	 * @param	Key				The key the service is mapped under
+	 * @param	Caller			Where the lookup is made from, which its failures are counted against (see FServiceLookupFailureSite)
 	 * @return	ServiceType*	The service instance
 	 */
 	template<typename ServiceType, typename ObjectType>
-	FORCEINLINE static ServiceType* GetService(const ObjectType* Object);
+	FORCEINLINE static ServiceType* GetService(const ObjectType* Object, FName Key, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER);
+
+	template<typename ServiceType, typename ObjectType>
+	FORCEINLINE static ServiceType* GetService(const ObjectType* Object, const FGameplayTag& Tag, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER) { return GetService<ServiceType>(Object, Tag.GetTagName(), Caller); }
+
+	/**
+	 * Gets the instance of the service specified by the ServiceType template parameter for each of many objects, e.g. every actor
+	 * managed by a system. Much cheaper than calling GetService() per object, as the service type is resolved and hashed once,
+	 * the interface is resolved once per run of objects of the same class, and neighbouring objects which share a container
+	 * share a lookup, so each distinct container costs a single hash find.
+	 * @param	Objects			The objects to find the service locator containers in
+	 * @param	OutServices		Receives a service instance per object, in the same order, which is null where none was found
+	 * @param	Caller			Where the lookup is made from, which its failures are counted against (see FServiceLookupFailureSite)
+	 */
+	template<typename ServiceType, typename ElementType>
+	static void GetServices(TArrayView<ElementType> Objects, TArray<ServiceType*>& OutServices, const FServiceLookupCaller& Caller = SERVICE_LOCATOR_CURRENT_CALLER);
 
 	/////////////////////
 	// Member Functions
 
+	/**
+	 * Sets the config used the next time services are located. Services that have already been located are unaffected.
+	 * @param	InConfig		The config to use
+	 */
+	FORCEINLINE void SetConfig(UServiceLocatorConfig* InConfig) { Config = InConfig; ConfigLayout.Reset(); }
+
+	FORCEINLINE UServiceLocatorConfig* GetConfig() const { return Config; }
+
+	// The config services were last located from, i.e. Config merged with any native services, see NativeServiceGroups
+	FORCEINLINE UServiceLocatorConfig* GetActiveConfig() const { return ActiveConfig; }
+
 	/**
 	 * According to the ServiceLocatorConfig, finds and/or creates services for retrieval
 	 */
 	void LocateAndCreateServices();
 
+	/**
+	 * According to the ServiceLocatorConfig, finds and/or creates services for retrieval over several frames,
+	 * spending at most AsyncLocateBudgetMs per frame. Critical services are located before this returns.
+	 * OnServicesLocated is broadcast once every service has been processed.
+	 */
+	void LocateAndCreateServicesAsync();
+
+	/**
+	 * Asynchronously loads every soft service class which this container may need to create, then locates and creates
+	 * services once they've all loaded. Classes of FindOnly services aren't loaded, as they can only be found once something
+	 * else has loaded them. The synchronous locate functions load any missing classes on the spot instead.
+	 * @param	bLocateAsync	Whether to use LocateAndCreateServicesAsync() once the classes are loaded
+	 */
+	void LoadAndLocateServicesAsync(bool bLocateAsync = false);
+
+	/**
+	 * Returns whether the container is still loading service classes, before locating services
+	 */
+	bool IsLoadingServiceClasses() const;
+
+	/**
+	 * Fills every UPROPERTY of Object marked with meta=(InjectService) with its service from this container.
+	 * Properties whose service isn't available are left untouched. If the container is still locating services,
+	 * Object is injected again once every service has been located.
+	 * Services located or created by this container are injected automatically once every service has been located.
+	 * @param	Object			The object to inject services into
+	 * @return	int32			The number of properties injected
+	 */
+	int32 InjectServices(UObject* Object);
+
+	/**
+	 * Writes the services this container resolved to a compact snapshot: which descriptor produced each service, where
+	 * each located service was found, and the SaveGame properties of every service. Doesn't include registered services or overrides.
+	 * @param	OutSnapshot		Receives the snapshot
+	 * @return	bool			Whether the snapshot was written
+	 */
+	bool SaveServicesSnapshot(TArray<uint8>& OutSnapshot) const;
+
+	/**
+	 * Restores services from a snapshot written by SaveServicesSnapshot(), in place of LocateAndCreateServices().
+	 * Located services are resolved by path, and created services are created without searching for an existing instance,
+	 * so there are no world scans. Any service which can't be restored is located as normal.
+	 * Descriptors which produced no service when the snapshot was taken are skipped.
+	 * @param	Snapshot		The snapshot to restore from
+	 * @return	bool			Whether the snapshot was compatible with this container's config. If not, nothing is restored.
+	 */
+	bool RestoreServicesFromSnapshot(const TArray<uint8>& Snapshot);
+
+	/**
+	 * Shuts down and destroys every service created by this container. Each service is shut down before the services injected into
+	 * it, and otherwise in reverse creation order.
+	 * All mappings are cleared before any service is shut down, so lookups made during shutdown return null.
+	 * Located services are unmapped but otherwise left alone, as the container doesn't own them.
+	 * @param	OutTimings		(Optional) Receives the time spent on each service, in shutdown order
+	 */
+	void ShutdownServices(TArray<FServiceShutdownTiming>* OutTimings = nullptr);
+
+	/**
+	 * Gets the tick cost of every service this container ticks, in tick order.
+	 * Services which implement IServiceTickInterface are ticked by the container in one batched pass, ordered by the
+	 * prerequisites and priority in their descriptor's TickSettings. Within each step of that order, thread safe services
+	 * tick in parallel on worker threads, then the rest tick on the game thread.
+	 * @param	OutTimings		Receives the timings
+	 */
+	void GetServiceTickTimings(TArray<FServiceTickTiming>& OutTimings) const;
+
+	/**
+	 * Returns whether every service which implements IServiceWarmUpInterface has warmed up since services were last located
+	 */
+	FORCEINLINE bool AreServicesWarm() const { return bServicesWarm && !IsLocatingServices() && !IsLoadingServiceClasses(); }
+
+	/**
+	 * Returns the fraction of services which have warmed up, from 0 to 1, e.g. for a loading screen
+	 */
+	float GetWarmUpProgress() const;
+
+	/**
+	 * Returns a number which changes whenever the services mapped by this container change
+	 */
+	FORCEINLINE uint32 GetServicesGeneration() const { return ServicesGeneration; }
+
+	/**
+	 * Returns whether the container is still asynchronously locating services
+	 */
+	FORCEINLINE bool IsLocatingServices() const { return AsyncDescriptorIndex != INDEX_NONE; }
+
 	/**
 	 * Returns an instance of the service specified by the ServiceType template parameter
 	 * @return	ServiceType*	The service instance
@@ -60,14 +254,199 @@ public:
 	template<typename ServiceType>
 	FORCEINLINE ServiceType* GetService() const;
 
+	/**
+	 * Returns an instance of the service specified by the ServiceType template parameter, first unmapping any services which
+	 * have been destroyed without the container noticing, e.g. object services, and recovering the service if its descriptor's
+	 * RecoveryBehaviour is OnNextLookup. Must be called on the game thread. GetService() never recovers services.
+	 * @return	ServiceType*	The service instance
+	 */
+	template<typename ServiceType>
+	ServiceType* GetOrRecoverService();
+
+	/**
+	 * Returns the instance of the service specified by the ServiceType template parameter which is mapped under Key
+	 * @param	Key				The key the service is mapped under
+	 * @return	ServiceType*	The service instance
+	 */
+	template<typename ServiceType>
+	FORCEINLINE ServiceType* GetKeyedService(FName Key) const;
+
+	template<typename ServiceType>
+	FORCEINLINE ServiceType* GetKeyedService(const FGameplayTag& Tag) const { return GetKeyedService<ServiceType>(Tag.GetTagName()); }
+
+	/**
+	 * Gets every keyed instance of the service specified by the ServiceType template parameter, in the order they were mapped
+	 * @param	OutServices		Receives the service instances
+	 */
+	template<typename ServiceType>
+	void GetKeyedServices(TArray<ServiceType*>& OutServices) const;
+
+	/**
+	 * Returns whether the service specified by the ServiceType template parameter is ready to be retrieved
+	 * @return	EServiceState	The state of the service
+	 */
+	template<typename ServiceType>
+	FORCEINLINE EServiceState GetServiceState() const;
+
+	/**
+	 * Returns a proxy for the service specified by the ServiceType template parameter, which may be passed to other threads.
+	 * Calls made through the proxy are run on the game thread when this container next ticks. Must be called on the game thread.
+	 * @return	TQueuedServiceProxy<ServiceType>	The proxy, which is invalid if the service is missing
+	 */
+	template<typename ServiceType>
+	TQueuedServiceProxy<ServiceType> GetQueuedServiceProxy() const;
+
+	/**
+	 * Maps a service instance to a type, as if it had been located from a descriptor. The container doesn't take
+	 * ownership of the instance, so it won't be shut down by ShutdownServices().
+	 * @param	MappedType		The type to map the service to
+	 * @param	ServiceInstance	The service instance
+	 */
+	void RegisterService(UClass* MappedType, UObject* ServiceInstance);
+
+	/**
+	 * Removes the mapping for a type, if the type is currently mapped to ServiceInstance
+	 * @param	MappedType		The type to unmap
+	 * @param	ServiceInstance	The service instance expected to be mapped to the type
+	 */
+	void UnregisterService(UClass* MappedType, UObject* ServiceInstance);
+
+#if SERVICE_LOCATOR_OVERRIDES
+	/**
+	 * Maps OverrideInstance to OverriddenType in place of the located service, until the override is removed.
+	 * Overrides stack, so removing one restores whatever was mapped before it. Compiled out of shipping builds.
+	 * @param	OverriddenType		The type to override
+	 * @param	OverrideInstance	The instance to map to the type
+	 */
+	void AddServiceOverride(UClass* OverriddenType, UObject* OverrideInstance);
+
+	/**
+	 * Removes an override added by AddServiceOverride()
+	 * @param	OverriddenType		The overridden type
+	 * @param	OverrideInstance	The instance the type was overridden with
+	 */
+	void RemoveServiceOverride(UClass* OverriddenType, UObject* OverrideInstance);
+
+	/**
+	 * Removes every override, restoring the located services
+	 */
+	void RemoveAllServiceOverrides();
+#endif
+
+	/**
+	 * Runs every call queued through proxies obtained from this container. Called automatically when the container ticks.
+	 */
+	void FlushQueuedServiceCalls();
+
+	/**
+	 * Gets the event bus through which this container's services publish and subscribe to events.
+	 * Events are dispatched when the container ticks, and subscribers are discarded by ShutdownServices().
+	 */
+	FORCEINLINE FServiceEventBus& GetEventBus() { return EventBus; }
+
+	/**
+	 * Dispatches every pending event on the event bus. Called automatically when the container ticks.
+	 */
+	void DispatchServiceEvents();
+
+	//////////////////////////////////////////////
+	// Overridden Functions - UObject
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
+
+	//////////////////////////////////////////////
+	// Delegates
+
+	// Broadcast once every service in the config has been processed, for both synchronous and asynchronous location
+	FOnServicesLocated OnServicesLocated;
+
+	// Broadcast once every service located or created by this container has warmed up, after OnServicesLocated.
+	// Broadcast straight away if no service needs to warm up.
+	FOnServicesWarm OnServicesWarm;
+
 protected:
 
+	template<typename ServiceType, typename ObjectType>
+	static UServiceLocatorContainer* GetContainerFromObject(const ObjectType* Object, const FServiceLookupCaller& Caller);
+
 	UObject* GetServiceInternal(const UClass* ServiceClass) const;
+	UObject* GetServiceInternalByHash(const UClass* ServiceClass, uint32 ServiceClassHash) const;
+	UObject* GetKeyedServiceInternal(const UClass* ServiceClass, FName Key) const;
+	EServiceState GetServiceStateInternal(const UClass* ServiceClass) const;
+
+	void LocateAndCreateService(const FServiceDescriptor& ServiceDescriptor, int32 DescriptorIndex);
+	void AddService(const FServiceDescriptor& ServiceDescriptor, int32 DescriptorIndex, UObject* ServiceInstance, bool bCreated);
+	void MapService(const FServiceDescriptor& ServiceDescriptor, int32 DescriptorIndex, UObject* ServiceInstance);
+	void MapKeyedService(UClass* MappedType, FName ServiceKey, UObject* ServiceInstance);
+	void TickAsyncLocate();
+	void FinishLocatingServices();
+
+	void ResolveActiveConfig();
+	void EvaluateDescriptorConditions();
+	FORCEINLINE bool IsDescriptorActive(int32 DescriptorIndex) const { return ActiveDescriptors.IsValidIndex(DescriptorIndex) && ActiveDescriptors[DescriptorIndex]; }
+	FORCEINLINE bool CanCreateService(const FServiceDescriptor& ServiceDescriptor) const { return (CreatableLocateBehaviours & (1 << static_cast<uint8>(ServiceDescriptor.LocateBehaviour))) != 0; }
+
+	void GatherServiceClassesToLoad(TArray<FSoftObjectPath>& OutClassPaths) const;
+	void HandleServiceClassesLoaded();
+	void LoadServiceClassesSynchronous();
+
+	// Writes services into the object's injection points. Only mapped services are injected; destroyed services aren't recovered here.
+	int32 InjectServicesInternal(UObject* Object);
+
+	const FServiceDescriptorLayout* GetDescriptorLayout(int32 DescriptorIndex);
+
+	// The object under which a service of the given type is searched for, against which snapshot paths are relative
+	UObject* GetServiceSearchRoot(const UClass* ServiceType) const;
+
+	ULevel* GetSpawnLevel(const FServiceSpawnSettings& SpawnSettings) const;
+	void FinishSpawningActorServices();
+
+	void AddPendingStreamedDescriptor(int32 DescriptorIndex);
+	void StopWaitingForStreamedServices();
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void HandleActorSpawned(AActor* Actor);
+
+	UFUNCTION()
+	void HandleOuterActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+	void MapStreamedActor(AActor* Actor);
+
+	void DestroyService(UObject* ServiceInstance, int32 DescriptorIndex);
+
+	AActor* GetTrackedActor(UObject* ServiceInstance) const;
+	void InvalidateDestroyedServices();
 
-	UObject* LocateOrCreateService(const FServiceDescriptor& ServiceDescriptor);
-	AActor* LocateOrCreateActorService(const FServiceDescriptor& ServiceDescriptor);
-	UActorComponent* LocateOrCreateComponentService(const FServiceDescriptor& ServiceDescriptor);
-	UObject* LocateOrCreateObjectService(const FServiceDescriptor& ServiceDescriptor);
+	UFUNCTION()
+	void HandleActorServiceDestroyed(AActor* DestroyedActor);
+
+	void InvalidateService(int32 ServiceIndex);
+	void UnmapService(UObject* ServiceInstance);
+	UObject* RecoverService(const UClass* ServiceClass);
+	void RecoverDescriptor(int32 DescriptorIndex);
+	void FinishRecoveringService(UObject* ServiceInstance);
+	void TickPendingRecovery();
+
+	struct FTickedService;
+
+	void StartTicking();
+	TFunction<void()> MakeStartTickingFunction();
+	void Tick(float DeltaTime);
+	bool HasTickWork() const;
+
+	void StartWarmingUpServices();
+	void FinishWarmingUpServices();
+	void WaitForWarmUp();
+	void WaitForServiceWarmUp(UObject* ServiceInstance);
+
+	void RebuildTickedServices();
+	void TickServices(float DeltaTime);
+	void TickService(FTickedService& TickedService, float DeltaTime);
+
+	UObject* LocateOrCreateService(const FServiceDescriptor& ServiceDescriptor, bool& bOutCreated, bool bSkipLocate = false);
+	AActor* LocateOrCreateActorService(const FServiceDescriptor& ServiceDescriptor, bool& bOutCreated, bool bSkipLocate = false);
+	UActorComponent* LocateOrCreateComponentService(const FServiceDescriptor& ServiceDescriptor, bool& bOutCreated, bool bSkipLocate = false);
+	UObject* LocateOrCreateObjectService(const FServiceDescriptor& ServiceDescriptor, bool& bOutCreated, bool bSkipLocate = false);
 
 	//////////////////////////////////////////////
 	// Tweakables
@@ -75,15 +454,202 @@ protected:
 	UPROPERTY(EditAnywhere)
 	UServiceLocatorConfig* Config = nullptr;
 
+	// (Optional) Groups of services registered with REGISTER_NATIVE_SERVICE, which are located ahead of the services in Config.
+	// A container with native services doesn't need a Config at all.
+	UPROPERTY(EditAnywhere)
+	TArray<FName> NativeServiceGroups;
+
+	// The maximum time, in milliseconds, spent locating services per frame when locating asynchronously
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.1", UIMin = "0.1"))
+	float AsyncLocateBudgetMs = 2.0f;
+
 	//////////////////////////////////////////////
 	// Data
 
+	// Config merged with the native services of NativeServiceGroups, or just Config if there are none, which services are located from
+	UPROPERTY(Transient)
+	UServiceLocatorConfig* ActiveConfig = nullptr;
+
 	UPROPERTY(Transient)
 	TArray<UObject*> Services;
 
+	// The validated layout of Config, shared through FServiceLocatorClassCache
+	TSharedPtr<const FServiceConfigLayout, ESPMode::ThreadSafe> ConfigLayout;
+
 	UPROPERTY(Transient)
 	TMap<UClass*, UObject*> MappedTypesToServices;
 
+	struct FKeyedServices
+	{
+		// Parallel arrays, so that a lookup only scans the keys
+		TArray<FName>		Keys;
+		TArray<UObject*>	Instances;
+	};
+
+	// Keyed services, stored contiguously per mapped type. Referenced through AddReferencedObjects().
+	TMap<UClass*, FKeyedServices> KeyedServices;
+
+	struct FServiceRecord
+	{
+		FServiceRecord(int32 InDescriptorIndex, bool bInCreated)
+			: DescriptorIndex(InDescriptorIndex)
+			, bCreated(bInCreated)
+		{
+		}
+
+		// The index of the descriptor in the config which produced the service
+		int32	DescriptorIndex;
+
+		// Whether the service was created by this container, rather than located
+		bool	bCreated;
+	};
+
+	// Parallel to Services
+	TArray<FServiceRecord> ServiceRecords;
+
+	uint32 ServicesGeneration = 0;
+
+	// Descriptors whose service was destroyed, to be recovered when the container next ticks
+	TArray<int32> PendingRecoveryDescriptorIndices;
+
+	// Types whose service was destroyed, mapped to the index of the descriptor to recover them from in GetOrRecoverService()
+	TMap<const UClass*, int32> LazyRecoveryTypes;
+
+#if SERVICE_LOCATOR_OVERRIDES
+	struct FServiceOverride
+	{
+		// The service that would be mapped to the type without any overrides
+		UObject*			UnderlyingInstance = nullptr;
+
+		// The overrides applied to the type, the last of which is mapped
+		TArray<UObject*>	OverrideInstances;
+	};
+
+	TMap<UClass*, FServiceOverride> ServiceOverrides;
+#endif
+
+	// The descriptors whose conditions were met when they were last evaluated, parallel to the config's descriptors
+	TBitArray<> ActiveDescriptors;
+
+	// A bit per EServiceLocationBehaviour which may create a service in this container's net mode
+	uint8 CreatableLocateBehaviours = 0;
+
+	// Types which may still be mapped while locating asynchronously
+	TSet<const UClass*> PendingMappedTypes;
+
+	// FindOnly actor descriptors which found nothing, and are waiting for their service to stream in with a level or be spawned
+	TArray<int32> PendingStreamedDescriptorIndices;
+
+	FDelegateHandle LevelAddedToWorldHandle;
+	FDelegateHandle ActorSpawnedHandle;
+	TWeakObjectPtr<UWorld> ActorSpawnedWorld;
+
+	// Bound once the container holds a component service, as a component destroyed on its own doesn't broadcast anything
+	FDelegateHandle PreGarbageCollectHandle;
+
+	/**
+	 * Ticks the container. Only exists while the container has work to do, see HasTickWork(), so that the thousands of
+	 * idle containers in a large world cost nothing per frame.
+	 */
+	class FContainerTicker : public FTickableGameObject
+	{
+	public:
+
+		explicit FContainerTicker(UServiceLocatorContainer& InContainer) : Container(InContainer) {}
+
+		//////////////////////////////////////////////
+		// Overridden Functions - FTickableGameObject
+
+		// May destroy this ticker, so mustn't touch it afterwards
+		virtual void Tick(float DeltaTime) override { Container.Tick(DeltaTime); }
+		virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Always; }
+		virtual TStatId GetStatId() const override;
+		virtual UWorld* GetTickableGameObjectWorld() const override { return Container.GetWorld(); }
+
+	private:
+
+		UServiceLocatorContainer& Container;
+
+	};
+
+	TUniquePtr<FContainerTicker> Ticker;
+
+	// Calls queued through proxies, which are drained on the game thread when the container ticks
+	TSharedRef<FServiceCallQueue, ESPMode::ThreadSafe> QueuedServiceCalls = MakeShared<FServiceCallQueue, ESPMode::ThreadSafe>();
+
+	// Events published by services, which are dispatched in one batch when the container ticks
+	FServiceEventBus EventBus;
+
+#if SERVICE_LOCATOR_THREAD_CHECKS
+	// Types mapped to services which may only be retrieved on the game thread
+	TSet<const UClass*> GameThreadOnlyMappedTypes;
+#endif
+
+	// The next descriptor to process while locating asynchronously, or INDEX_NONE when not locating asynchronously
+	int32 AsyncDescriptorIndex = INDEX_NONE;
+
+	struct FTickedService
+	{
+		TWeakObjectPtr<UObject>	Service;
+		IServiceTickInterface*	TickInterface			= nullptr;
+
+		// Services only depend on services in earlier waves
+		int32					Wave					= 0;
+		int32					Priority				= 0;
+		bool					bParallel				= false;
+		float					BudgetMs				= 0.0f;
+
+		double					LastMilliseconds		= 0.0;
+		double					PeakMilliseconds		= 0.0;
+		int32					NumOverruns				= 0;
+		int32					NumUnreportedOverruns	= 0;
+		double					LastOverrunWarningTime	= 0.0;
+	};
+
+	struct FWarmUpTask
+	{
+		// Referenced through AddReferencedObjects(), so that the service outlives its task even if it's destroyed
+		UObject*		ServiceInstance	= nullptr;
+		FGraphEventRef	Task;
+	};
+
+	// Warm-up tasks dispatched to worker threads since the services were last warm
+	TArray<FWarmUpTask> WarmUpTasks;
+
+	// Services which have been warmed up, so that they're only warmed up once
+	TSet<TWeakObjectPtr<UObject>> WarmedServices;
+	bool bServicesWarm = false;
+
+	// Services which implement IServiceTickInterface, contiguous in tick order, rebuilt whenever the services change
+	TArray<FTickedService> TickedServices;
+	uint32 TickedServicesGeneration = 0;
+
+	// The in-flight load of service classes started by LoadAndLocateServicesAsync()
+	TSharedPtr<FStreamableHandle> ServiceClassesHandle;
+	bool bLocateAsyncOnceLoaded = false;
+
+	// Objects injected while services were still being located, which are injected again once they have been
+	TArray<TWeakObjectPtr<UObject>> PendingInjectionTargets;
+
+	// Every object injected through InjectServices(), which is injected again whenever a destroyed service is recovered
+	TSet<TWeakObjectPtr<UObject>> InjectionTargets;
+
+	// The number of injection targets after stale ones were last removed, so that they're only removed once the set has doubled
+	int32 NumInjectionTargetsAfterCompaction = 0;
+
+	struct FDeferredActorService
+	{
+		AActor*		Actor			= nullptr;
+		FTransform	SpawnTransform;
+
+		// False for actors created by a factory, which have already finished spawning, and are only injected with the batch
+		bool		bFinishSpawning	= true;
+	};
+
+	// Actor services whose construction is deferred until every service in the current batch has been located
+	TArray<FDeferredActorService> DeferredActorServices;
+	bool bDeferActorServiceSpawning = false;
+
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -99,30 +665,181 @@ ServiceType* UServiceLocatorContainer::GetService() const
 
 ///////////////////////////////////////////////////////////////////////
 
+template<typename ServiceType>
+ServiceType* UServiceLocatorContainer::GetOrRecoverService()
+{
+	UClass* ServiceTypeClass = TGetServiceClassType<ServiceType>::Execute();
+	check(ServiceTypeClass != nullptr);
+
+	return TGetServicePointer<ServiceType>::Execute(RecoverService(ServiceTypeClass), ServiceTypeClass);
+}
+
+///////////////////////////////////////////////////////////////////////
+
+template<typename ServiceType>
+ServiceType* UServiceLocatorContainer::GetKeyedService(FName Key) const
+{
+	UClass* ServiceTypeClass = TGetServiceClassType<ServiceType>::Execute();
+	check(ServiceTypeClass != nullptr);
+
+	return TGetServicePointer<ServiceType>::Execute(GetKeyedServiceInternal(ServiceTypeClass, Key), ServiceTypeClass);
+}
+
+///////////////////////////////////////////////////////////////////////
+
+template<typename ServiceType>
+void UServiceLocatorContainer::GetKeyedServices(TArray<ServiceType*>& OutServices) const
+{
+	UClass* ServiceTypeClass = TGetServiceClassType<ServiceType>::Execute();
+	check(ServiceTypeClass != nullptr);
+
+	OutServices.Reset();
+
+	const FKeyedServices* TypeKeyedServices = KeyedServices.Find(ServiceTypeClass);
+	if (TypeKeyedServices == nullptr)
+	{
+		return;
+	}
+
+	OutServices.Reserve(TypeKeyedServices->Instances.Num());
+	for (UObject* ServiceObject : TypeKeyedServices->Instances)
+	{
+		if (IsValid(ServiceObject))
+		{
+			OutServices.Emplace(TGetServicePointer<ServiceType>::Execute(ServiceObject, ServiceTypeClass));
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+
+template<typename ServiceType>
+EServiceState UServiceLocatorContainer::GetServiceState() const
+{
+	UClass* ServiceTypeClass = TGetServiceClassType<ServiceType>::Execute();
+	check(ServiceTypeClass != nullptr);
+
+	return GetServiceStateInternal(ServiceTypeClass);
+}
+
+///////////////////////////////////////////////////////////////////////
+
+template<typename ServiceType>
+TQueuedServiceProxy<ServiceType> UServiceLocatorContainer::GetQueuedServiceProxy() const
+{
+	check(IsInGameThread());
+
+	UClass* ServiceTypeClass = TGetServiceClassType<ServiceType>::Execute();
+	check(ServiceTypeClass != nullptr);
+
+	UObject* ServiceObject = GetServiceInternal(ServiceTypeClass);
+	ServiceType* Service = TGetServicePointer<ServiceType>::Execute(ServiceObject, ServiceTypeClass);
+	if (Service == nullptr)
+	{
+		return TQueuedServiceProxy<ServiceType>();
+	}
+
+	return TQueuedServiceProxy<ServiceType>(Service, ServiceObject, QueuedServiceCalls);
+}
+
+///////////////////////////////////////////////////////////////////////
+
 template<typename ServiceType, typename ObjectType>
-ServiceType* UServiceLocatorContainer::GetService(const ObjectType* Object)
+UServiceLocatorContainer* UServiceLocatorContainer::GetContainerFromObject(const ObjectType* Object, const FServiceLookupCaller& Caller)
 {
 	if (Object == nullptr)
 	{
-		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::GetService<%s>: A null object was passed!"), *TGetServiceClassType<ServiceType>::Execute()->GetName());
+		SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("UServiceLocatorContainer::GetService"), TEXT("A null object was passed!"), TGetServiceClassType<ServiceType>::Execute(),
+			TEXT("UServiceLocatorContainer::GetService<%s>: A null object was passed!"), *TGetServiceClassType<ServiceType>::Execute()->GetName());
 		return nullptr;
 	}
 
 	const IServiceLocatorInterface* ObjectAsSLI = TGetObjectAsSLI<ObjectType>::Execute(Object);
 	if (ObjectAsSLI == nullptr)
 	{
-		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::GetService<%s>: Object '%s' does not implement IServiceLocatorInterface!"), *TGetServiceClassType<ServiceType>::Execute()->GetName(), *GetNameSafe(Cast<const UObject>(Object)));
+		// Objects which can't implement IServiceLocatorInterface, e.g. engine actors, may have had a container attached instead
+		if (UServiceLocatorContainer* AttachedContainer = TFindAttachedContainer<ObjectType>::Execute(Object))
+		{
+			return AttachedContainer;
+		}
+
+		SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("UServiceLocatorContainer::GetService"), TEXT("Object does not implement IServiceLocatorInterface!"), TGetServiceClassType<ServiceType>::Execute(),
+			TEXT("UServiceLocatorContainer::GetService<%s>: Object '%s' does not implement IServiceLocatorInterface!"), *TGetServiceClassType<ServiceType>::Execute()->GetName(), *GetNameSafe(Cast<const UObject>(Object)));
 		return nullptr;
 	}
 
 	UServiceLocatorContainer* Container = ObjectAsSLI->GetContainer();
 	if (Container == nullptr)
 	{
-		UE_LOG(LogUnrealServiceLocator, Warning, TEXT("UServiceLocatorContainer::GetService<%s>: Object '%s' did not return a UServiceLocatorContainer!"), *TGetServiceClassType<ServiceType>::Execute()->GetName(), *GetNameSafe(Cast<const UObject>(Object)));
+		SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, TEXT("UServiceLocatorContainer::GetService"), TEXT("Object did not return a UServiceLocatorContainer!"), TGetServiceClassType<ServiceType>::Execute(),
+			TEXT("UServiceLocatorContainer::GetService<%s>: Object '%s' did not return a UServiceLocatorContainer!"), *TGetServiceClassType<ServiceType>::Execute()->GetName(), *GetNameSafe(Cast<const UObject>(Object)));
 		return nullptr;
 	}
 
-	return Container->GetService<ServiceType>();
+	return Container;
+}
+
+///////////////////////////////////////////////////////////////////////
+
+template<typename ServiceType, typename ObjectType>
+ServiceType* UServiceLocatorContainer::GetService(const ObjectType* Object, const FServiceLookupCaller& Caller)
+{
+	UServiceLocatorContainer* Container = GetContainerFromObject<ServiceType>(Object, Caller);
+	return (Container != nullptr) ? Container->GetService<ServiceType>() : nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////
+
+template<typename ServiceType, typename ObjectType>
+ServiceType* UServiceLocatorContainer::GetService(const ObjectType* Object, FName Key, const FServiceLookupCaller& Caller)
+{
+	UServiceLocatorContainer* Container = GetContainerFromObject<ServiceType>(Object, Caller);
+	return (Container != nullptr) ? Container->GetKeyedService<ServiceType>(Key) : nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////
+
+template<typename ServiceType, typename ElementType>
+void UServiceLocatorContainer::GetServices(TArrayView<ElementType> Objects, TArray<ServiceType*>& OutServices, const FServiceLookupCaller& Caller)
+{
+	// Elements may be const or non-const pointers, e.g. from a TArray<AActor*> or a const TArray<const AActor*>
+	using ObjectType = typename TRemoveCV<typename TRemovePointer<typename TRemoveCV<ElementType>::Type>::Type>::Type;
+
+	UClass* ServiceTypeClass = TGetServiceClassType<ServiceType>::Execute();
+	check(ServiceTypeClass != nullptr);
+
+	const uint32 ServiceTypeHash = GetTypeHash(ServiceTypeClass);
+
+	OutServices.Reset(Objects.Num());
+	OutServices.AddUninitialized(Objects.Num());
+
+	// The interface is resolved once per run of objects of the same class, rather than per object
+	TBatchedGetObjectAsSLI<ObjectType> GetObjectAsSLI;
+
+	// Neighbouring objects often share a container, e.g. the components of an actor, in which case the last lookup is reused
+	const UServiceLocatorContainer* LastContainer = nullptr;
+	ServiceType* LastService = nullptr;
+
+	for (int32 ObjectIndex = 0; ObjectIndex < Objects.Num(); ++ObjectIndex)
+	{
+		const ObjectType* Object = Objects[ObjectIndex];
+		const IServiceLocatorInterface* ObjectAsSLI = GetObjectAsSLI.Execute(Object);
+
+		// Null objects, attached containers and failures take the full path, which handles and reports them
+		const UServiceLocatorContainer* Container = (ObjectAsSLI != nullptr) ? ObjectAsSLI->GetContainer() : nullptr;
+		if (Container == nullptr)
+		{
+			Container = GetContainerFromObject<ServiceType, ObjectType>(Object, Caller);
+		}
+
+		if (Container != LastContainer)
+		{
+			LastContainer = Container;
+			LastService = (Container != nullptr) ? TGetServicePointer<ServiceType>::Execute(Container->GetServiceInternalByHash(ServiceTypeClass, ServiceTypeHash), ServiceTypeClass) : nullptr;
+		}
+
+		OutServices[ObjectIndex] = LastService;
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorContainerRegistry.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "CoreMinimal.h"
+
+// Forward Declarations
+class IServiceLocatorInterface;
+class UObject;
+class UServiceLocatorContainer;
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Resolves objects to their service locator container without a per-call interface cast.
+ * Where IServiceLocatorInterface lives within each class is cached by the class's object index the first time it's needed,
+ * in a lock-free table, so that lookups from any thread never contend.
+ * Objects which can't implement the interface, e.g. engine or third-party actors, can have a container attached instead,
+ * which is held on the object's index, and is removed automatically when the object is destroyed.
+ */
+class UNREALSERVICELOCATOR_API FServiceLocatorContainerRegistry
+{
+public:
+
+	/**
+	 * Gets Object as an IServiceLocatorInterface, equivalent to Cast<const IServiceLocatorInterface>(Object)
+	 * @param	Object								The object to get the interface of
+	 * @return	const IServiceLocatorInterface*		The interface, or null if Object is null or its class doesn't implement it
+	 */
+	static const IServiceLocatorInterface* GetObjectAsSLI(const UObject* Object);
+
+	/**
+	 * Gets the offset of IServiceLocatorInterface within Object, which is the same for every instance of Object's class
+	 * @param	Object		The object to get the interface offset of, which mustn't be null
+	 * @return	int32		The offset, or INDEX_NONE if Object's class doesn't implement the interface
+	 */
+	static int32 GetInterfaceOffset(const UObject* Object);
+
+	/**
+	 * Attaches Container to Owner, so that services can be retrieved through Owner as if it implemented IServiceLocatorInterface
+	 */
+	static void AttachContainer(const UObject* Owner, UServiceLocatorContainer* Container);
+
+	/**
+	 * Detaches Container from Owner, if it's the container attached to Owner
+	 */
+	static void DetachContainer(const UObject* Owner, UServiceLocatorContainer* Container);
+
+	/**
+	 * Gets the container attached to Owner
+	 * @return	UServiceLocatorContainer*	The container, or null if none is attached
+	 */
+	static UServiceLocatorContainer* FindAttachedContainer(const UObject* Owner);
+
+	/**
+	 * Gets a number which changes whenever an object may have started resolving to a different container, i.e. whenever a
+	 * container is created or destroyed, attached or detached, or InvalidateResolvedContainers() is called. Caches of the
+	 * container an object resolves to compare it to tell whether they may be stale.
+	 */
+	static uint32 GetContainersGeneration();
+
+	/**
+	 * Marks every cached container resolution as stale, e.g. when an object's GetContainer() starts returning another existing container
+	 */
+	static void InvalidateResolvedContainers();
+
+};
+
+///////////////////////////////////////////////////////////////////////////
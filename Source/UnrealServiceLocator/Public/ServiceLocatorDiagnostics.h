@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorDiagnostics.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "CoreMinimal.h"
+#include "HAL/PlatformAtomics.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * The source location a service lookup was made from, so that its failures can be counted per call site. The public lookup
+ * functions take one as a defaulted last parameter, which captures the location of their caller where the compiler allows it.
+ */
+struct FServiceLookupCaller
+{
+	FServiceLookupCaller() = default;
+
+	FServiceLookupCaller(const ANSICHAR* InFile, int32 InLine)
+		: File(InFile)
+		, Line(InLine)
+	{
+	}
+
+	const ANSICHAR*	File	= nullptr;
+	int32			Line	= 0;
+};
+
+// The location of the code which expands this, or of the caller when used as a default argument. Without the builtins, the
+// location is unknown, and failures are counted per function as a whole; pass FServiceLookupCaller(__FILE__, __LINE__) instead.
+#if defined(__clang__) || defined(__GNUC__) || (defined(_MSC_VER) && (_MSC_VER >= 1929))
+	#define SERVICE_LOCATOR_CURRENT_CALLER FServiceLookupCaller(__builtin_FILE(), __builtin_LINE())
+#else
+	#define SERVICE_LOCATOR_CURRENT_CALLER FServiceLookupCaller()
+#endif
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * A place where a service lookup can fail. Sites are static, so there's one per expansion of SERVICE_LOCATOR_LOOKUP_FAILURE,
+ * or per instantiation when expanded in a function template, e.g. one per service type for the static
+ * UServiceLocatorContainer::GetService(). When the caller's location is known, each caller gets a site of its own, created
+ * on its first failure. Only the first failure at a site is logged in full; after that, failures are only counted, and
+ * summarised periodically by FServiceLocatorDiagnostics.
+ */
+class UNREALSERVICELOCATOR_API FServiceLookupFailureSite : public FNoncopyable
+{
+public:
+
+	FServiceLookupFailureSite(const TCHAR* InCallSite, const TCHAR* InReason);
+	FServiceLookupFailureSite(const FServiceLookupFailureSite& InParentSite, const FServiceLookupCaller& InCaller);
+	~FServiceLookupFailureSite();
+
+	/**
+	 * Gets the site counting this site's failures from Caller, creating it on first use
+	 * @return	FServiceLookupFailureSite&	The caller's own site, or this site if the caller's location is unknown
+	 */
+	FORCEINLINE FServiceLookupFailureSite& ForCaller(const FServiceLookupCaller& Caller)
+	{
+		return (Caller.File != nullptr) ? FindOrAddCallerSite(Caller) : *this;
+	}
+
+	/**
+	 * Gets the location this site's failures were called from, e.g. " (called from MyActor.cpp:42)", or an empty string if it's unknown
+	 */
+	FString GetCallerLabel() const;
+
+	/**
+	 * Counts a failure at this site
+	 * @return	bool			Whether this was the first failure, in which case the caller should log the full message
+	 */
+	FORCEINLINE bool Record()
+	{
+		return FPlatformAtomics::InterlockedIncrement(&Count) == 1;
+	}
+
+	/**
+	 * Sets the service type looked up at this site, used when summarising its failures
+	 */
+	FORCEINLINE void SetServiceClass(const UClass* InServiceClass)
+	{
+		ServiceClass = InServiceClass;
+	}
+
+private:
+
+	friend class FServiceLocatorDiagnostics;
+
+	FServiceLookupFailureSite& FindOrAddCallerSite(const FServiceLookupCaller& Caller);
+
+	const TCHAR*						CallSite;
+	const TCHAR*						Reason;
+	const UClass*						ServiceClass	= nullptr;
+	volatile int32						Count			= 0;
+	int32								ReportedCount	= 0;
+	FServiceLookupFailureSite*			NextSite		= nullptr;
+
+	// Set for the sites of individual callers, which are owned by FServiceLocatorDiagnostics and removed with their parent
+	const FServiceLookupFailureSite*	ParentSite		= nullptr;
+	TArray<ANSICHAR>					CallerFile;
+	int32								CallerLine		= 0;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+class UNREALSERVICELOCATOR_API FServiceLocatorDiagnostics
+{
+public:
+
+	static void Startup();
+	static void Shutdown();
+
+	/**
+	 * Logs the failures recorded at every site since the last summary, if any
+	 */
+	static void LogSummary();
+
+	/**
+	 * Logs the total failures recorded at every site
+	 */
+	static void DumpCounters();
+
+	/**
+	 * Resets every counter, so that the next failure at each site is logged in full again
+	 */
+	static void ResetCounters();
+
+private:
+
+	friend class FServiceLookupFailureSite;
+
+	static void RegisterSite(FServiceLookupFailureSite* Site);
+	static void UnregisterSite(FServiceLookupFailureSite* Site);
+
+	static FServiceLookupFailureSite& FindOrAddCallerSite(const FServiceLookupFailureSite* ParentSite, const FServiceLookupCaller& Caller);
+
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Records a lookup failure against a site unique to the expansion and Caller (see FServiceLookupFailureSite), logging the message at
+ * Warning verbosity the first time the site fails. ServiceClass and the format arguments are only evaluated when the message is logged.
+ */
+#define SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(Caller, CallSite, Reason, ServiceClass, Format, ...) \
+	do \
+	{ \
+		static FServiceLookupFailureSite LookupFailureSite(CallSite, Reason); \
+		FServiceLookupFailureSite& CallerFailureSite = LookupFailureSite.ForCaller(Caller); \
+		if (CallerFailureSite.Record()) \
+		{ \
+			CallerFailureSite.SetServiceClass(ServiceClass); \
+			UE_LOG(LogUnrealServiceLocator, Warning, TEXT("%s%s"), *FString::Printf(Format, ##__VA_ARGS__), *CallerFailureSite.GetCallerLabel()); \
+		} \
+	} while (0)
+
+/**
+ * Records a lookup failure against a site unique to the expansion, for failures which don't depend on the caller
+ */
+#define SERVICE_LOCATOR_LOOKUP_FAILURE(CallSite, Reason, ServiceClass, Format, ...) \
+	SERVICE_LOCATOR_LOOKUP_FAILURE_FROM(FServiceLookupCaller(), CallSite, Reason, ServiceClass, Format, ##__VA_ARGS__)
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,247 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorEventBus.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/Class.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+class IServiceEventChannel
+{
+public:
+
+	virtual ~IServiceEventChannel() = default;
+
+	/**
+	 * Dispatches every event published since the last dispatch to every subscriber, in the order they were published
+	 */
+	virtual void Dispatch() = 0;
+
+	// Whether this channel may be dispatched on a worker thread, in parallel with other such channels
+	bool bDispatchInParallel = false;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+template<typename EventType>
+class TServiceEventChannel : public IServiceEventChannel
+{
+public:
+
+	using FEventHandler = TFunction<void(const EventType&)>;
+
+	template<typename ArgType>
+	void Publish(ArgType&& Event)
+	{
+		FScopeLock ScopeLock(&PendingEventsCriticalSection);
+		PendingEvents.Emplace(Forward<ArgType>(Event));
+	}
+
+	FDelegateHandle Subscribe(FEventHandler&& Handler)
+	{
+		const FDelegateHandle Handle(FDelegateHandle::GenerateNewHandle);
+
+		// Subscribers can't be added while dispatching, as that could reallocate the handler being called
+		TArray<TPair<FDelegateHandle, FEventHandler>>& TargetSubscribers = bIsDispatching ? AddedSubscribers : Subscribers;
+		TargetSubscribers.Emplace(Handle, MoveTemp(Handler));
+
+		return Handle;
+	}
+
+	void Unsubscribe(FDelegateHandle Handle)
+	{
+		// Handles are only invalidated here, and removed after dispatching
+		for (TPair<FDelegateHandle, FEventHandler>& Subscriber : Subscribers)
+		{
+			if (Subscriber.Key == Handle)
+			{
+				Subscriber.Key.Reset();
+			}
+		}
+
+		AddedSubscribers.RemoveAll([Handle](const TPair<FDelegateHandle, FEventHandler>& Subscriber) { return Subscriber.Key == Handle; });
+		bHasRemovedSubscribers = true;
+	}
+
+	//////////////////////////////////////////////
+	// Overridden Functions - IServiceEventChannel
+
+	virtual void Dispatch() override
+	{
+		{
+			FScopeLock ScopeLock(&PendingEventsCriticalSection);
+			Swap(PendingEvents, DispatchingEvents);
+		}
+
+		bIsDispatching = true;
+
+		const int32 NumSubscribers = Subscribers.Num();
+		for (const EventType& Event : DispatchingEvents)
+		{
+			for (int32 SubscriberIndex = 0; SubscriberIndex < NumSubscribers; ++SubscriberIndex)
+			{
+				const TPair<FDelegateHandle, FEventHandler>& Subscriber = Subscribers[SubscriberIndex];
+				if (Subscriber.Key.IsValid())
+				{
+					Subscriber.Value(Event);
+				}
+			}
+		}
+
+		bIsDispatching = false;
+
+		DispatchingEvents.Reset();
+
+		if (bHasRemovedSubscribers)
+		{
+			Subscribers.RemoveAll([](const TPair<FDelegateHandle, FEventHandler>& Subscriber) { return !Subscriber.Key.IsValid(); });
+			bHasRemovedSubscribers = false;
+		}
+
+		if (AddedSubscribers.Num() > 0)
+		{
+			Subscribers.Append(MoveTemp(AddedSubscribers));
+			AddedSubscribers.Reset();
+		}
+	}
+
+private:
+
+	FCriticalSection								PendingEventsCriticalSection;
+	TArray<EventType>								PendingEvents;
+	TArray<EventType>								DispatchingEvents;
+
+	TArray<TPair<FDelegateHandle, FEventHandler>>	Subscribers;
+	TArray<TPair<FDelegateHandle, FEventHandler>>	AddedSubscribers;
+	bool											bIsDispatching			= false;
+	bool											bHasRemovedSubscribers	= false;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * A typed event channel for services, keyed by USTRUCT event type. Published events are buffered contiguously per type,
+ * then dispatched to subscribers in one batched pass when the owning container ticks.
+ * Events may be published from any thread; subscribing, unsubscribing and dispatching must happen on the game thread.
+ * Channels are reference counted, so a publisher racing Reset() publishes into a discarded channel rather than a freed one.
+ */
+class UNREALSERVICELOCATOR_API FServiceEventBus : public FNoncopyable
+{
+public:
+
+	/**
+	 * Queues an event for the next dispatch
+	 * @param	Event			The event to publish
+	 */
+	template<typename EventType>
+	void Publish(EventType&& Event)
+	{
+		using FDecayedEventType = typename TDecay<EventType>::Type;
+
+		// The channel is kept alive until the event is queued, in case the bus is reset on the game thread meanwhile
+		const TSharedRef<TServiceEventChannel<FDecayedEventType>, ESPMode::ThreadSafe> Channel = GetChannel<FDecayedEventType>();
+		Channel->Publish(Forward<EventType>(Event));
+
+		if ((NumPendingEvents.Increment() == 1) && OnFirstEventPublished)
+		{
+			OnFirstEventPublished();
+		}
+	}
+
+	/**
+	 * Calls Handler for every event of type EventType, when events are dispatched
+	 * @param	Handler			The handler to call
+	 * @return	FDelegateHandle	A handle with which to unsubscribe
+	 */
+	template<typename EventType>
+	FDelegateHandle Subscribe(TFunction<void(const EventType&)>&& Handler)
+	{
+		check(IsInGameThread());
+		return GetChannel<EventType>()->Subscribe(MoveTemp(Handler));
+	}
+
+	template<typename EventType>
+	void Unsubscribe(FDelegateHandle Handle)
+	{
+		check(IsInGameThread());
+		GetChannel<EventType>()->Unsubscribe(Handle);
+	}
+
+	/**
+	 * Sets whether events of type EventType are dispatched on worker threads, in parallel with other such event types.
+	 * Subscribers to parallel event types must be thread safe.
+	 */
+	template<typename EventType>
+	void SetDispatchInParallel(bool bDispatchInParallel)
+	{
+		check(IsInGameThread());
+		GetChannel<EventType>()->bDispatchInParallel = bDispatchInParallel;
+	}
+
+	/**
+	 * Dispatches every pending event. Events published during dispatch are queued for the next dispatch.
+	 */
+	void Dispatch();
+
+	FORCEINLINE bool HasPendingEvents() const { return NumPendingEvents.GetValue() > 0; }
+
+	/**
+	 * Sets a function called whenever an event is published while none are pending, on the publishing thread. Must be set before any events are published.
+	 */
+	FORCEINLINE void SetOnFirstEventPublished(TFunction<void()>&& InOnFirstEventPublished) { OnFirstEventPublished = MoveTemp(InOnFirstEventPublished); }
+
+	/**
+	 * Discards every channel, along with its subscribers and pending events. Events published concurrently may be discarded too.
+	 */
+	void Reset();
+
+private:
+
+	using FChannelPtr = TSharedPtr<IServiceEventChannel, ESPMode::ThreadSafe>;
+
+	template<typename EventType>
+	TSharedRef<TServiceEventChannel<EventType>, ESPMode::ThreadSafe> GetChannel()
+	{
+		const UScriptStruct* EventStruct = EventType::StaticStruct();
+
+		{
+			FReadScopeLock ReadScopeLock(ChannelsLock);
+
+			const FChannelPtr* Channel = Channels.Find(EventStruct);
+			if (Channel != nullptr)
+			{
+				return StaticCastSharedRef<TServiceEventChannel<EventType>>(Channel->ToSharedRef());
+			}
+		}
+
+		FWriteScopeLock WriteScopeLock(ChannelsLock);
+
+		FChannelPtr& Channel = Channels.FindOrAdd(EventStruct);
+		if (!Channel.IsValid())
+		{
+			Channel = MakeShared<TServiceEventChannel<EventType>, ESPMode::ThreadSafe>();
+		}
+
+		return StaticCastSharedRef<TServiceEventChannel<EventType>>(Channel.ToSharedRef());
+	}
+
+	FRWLock												ChannelsLock;
+	TMap<const UScriptStruct*, FChannelPtr>				Channels;
+
+	FThreadSafeCounter									NumPendingEvents;
+	TFunction<void()>									OnFirstEventPublished;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
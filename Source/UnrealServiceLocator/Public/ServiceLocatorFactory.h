@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorFactory.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/Object.h"
+
+// UnrealServiceLocator
+#include "ServiceLocatorFactory.generated.h"
+
+// Forward Declarations
+class UServiceLocatorContainer;
+struct FServiceDescriptor;
+
+///////////////////////////////////////////////////////////////////////////
+
+UCLASS(Abstract, EditInlineNew, DefaultToInstanced, CollapseCategories)
+class UNREALSERVICELOCATOR_API UServiceFactory : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Creates an instance of the service, called when a container fails to locate it and is allowed to create it.
+	 * Actor services should be spawned into the container's world, and component services created in and registered with
+	 * the container's actor. Actor services must have finished spawning, so the descriptor's SpawnSettings are up to the factory
+	 * to apply; the container only injects them, along with the rest of the services located with them.
+	 * @param	Container			The container requesting the service
+	 * @param	ServiceDescriptor	The descriptor of the service to create
+	 * @return	UObject*			The new service instance, or null if it couldn't be created
+	 */
+	virtual UObject* CreateService(UServiceLocatorContainer* Container, const FServiceDescriptor& ServiceDescriptor) PURE_VIRTUAL(UServiceFactory::CreateService, return nullptr;);
+
+	/**
+	 * Called when a container shuts down a service this factory created, after the service has been shut down.
+	 * @param	Container			The container releasing the service
+	 * @param	ServiceInstance		The service instance
+	 * @return	bool				Whether the factory took care of the instance; if not, the container destroys it as normal
+	 */
+	virtual bool DestroyService(UServiceLocatorContainer* Container, UObject* ServiceInstance) { return false; }
+
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Recycles instances of object services rather than creating a new UObject each time the service is needed.
+ * Instances are pooled per world, in UPooledServiceSubsystem, so they never outlive the world they were used in, nor are they
+ * shared between worlds, e.g. PIE instances. Service types must implement IServicePoolInterface, which resets them on release and reuse.
+ */
+UCLASS(meta = (DisplayName = "Pooled Object Service Factory"))
+class UNREALSERVICELOCATOR_API UPooledServiceFactory : public UServiceFactory
+{
+	GENERATED_BODY()
+
+public:
+
+	//////////////////////////////////////////////
+	// Overridden Functions - UServiceFactory
+
+	virtual UObject* CreateService(UServiceLocatorContainer* Container, const FServiceDescriptor& ServiceDescriptor) override;
+	virtual bool DestroyService(UServiceLocatorContainer* Container, UObject* ServiceInstance) override;
+
+protected:
+
+	//////////////////////////////////////////////
+	// Tweakables
+
+	// The maximum number of released instances kept for reuse, per world
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxPooledInstances = 16;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+USTRUCT()
+struct FPooledServiceInstances
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(Transient)
+	TArray<UObject*> Instances;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Holds the instances released to each UPooledServiceFactory in a world, which are outered to this subsystem while pooled,
+ * and are destroyed along with the world.
+ */
+UCLASS()
+class UNREALSERVICELOCATOR_API UPooledServiceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Takes a released instance of ServiceType out of Factory's pool
+	 * @return	UObject*	The instance, renamed under NewOuter, or null if none is pooled
+	 */
+	UObject* TakeInstance(UPooledServiceFactory* Factory, UClass* ServiceType, UObject* NewOuter);
+
+	/**
+	 * Releases ServiceInstance into Factory's pool, unless it's full
+	 * @return	bool		Whether the instance was pooled
+	 */
+	bool ReleaseInstance(UPooledServiceFactory* Factory, UObject* ServiceInstance, int32 MaxPooledInstances);
+
+	//////////////////////////////////////////////
+	// Overridden Functions - USubsystem
+
+	virtual void Deinitialize() override;
+
+protected:
+
+	//////////////////////////////////////////////
+	// Data
+
+	UPROPERTY(Transient)
+	TMap<UPooledServiceFactory*, FPooledServiceInstances> Pools;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
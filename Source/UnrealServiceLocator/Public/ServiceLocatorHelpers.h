@@ -7,6 +7,7 @@
 #include "Templates/UnrealTemplate.h"
 
 // UnrealServiceLocator
+#include "ServiceLocatorContainerRegistry.h"
 #include "ServiceLocatorInterface.h"
 
 ///////////////////////////////////////////////////////////////////////
@@ -28,11 +29,13 @@ struct TIsUInterface<T, true>
 
 ///////////////////////////////////////////////////////////////////////
 
-template<typename ObjectType, bool bObjectIsSLIDerived = TPointerIsConvertibleFromTo<ObjectType, const volatile IServiceLocatorInterface>::Value>
+template<typename ObjectType,
+	bool bObjectIsSLIDerived = TPointerIsConvertibleFromTo<ObjectType, const volatile IServiceLocatorInterface>::Value,
+	bool bObjectIsUObject = TPointerIsConvertibleFromTo<ObjectType, const volatile UObject>::Value>
 struct TGetObjectAsSLI;
 
-template<typename ObjectType>
-struct TGetObjectAsSLI<ObjectType, true /* bObjectIsSLIDerived */>
+template<typename ObjectType, bool bObjectIsUObject>
+struct TGetObjectAsSLI<ObjectType, true /* bObjectIsSLIDerived */, bObjectIsUObject>
 {
 	static const IServiceLocatorInterface* Execute(const IServiceLocatorInterface* Object)
 	{
@@ -41,7 +44,17 @@ struct TGetObjectAsSLI<ObjectType, true /* bObjectIsSLIDerived */>
 };
 
 template<typename ObjectType>
-struct TGetObjectAsSLI<ObjectType, false /* bObjectIsSLIDerived */>
+struct TGetObjectAsSLI<ObjectType, false /* bObjectIsSLIDerived */, true /* bObjectIsUObject */>
+{
+	// The interface's offset is cached per class, rather than searching the class's interfaces on every call
+	static const IServiceLocatorInterface* Execute(const ObjectType* Object)
+	{
+		return FServiceLocatorContainerRegistry::GetObjectAsSLI(Object);
+	}
+};
+
+template<typename ObjectType>
+struct TGetObjectAsSLI<ObjectType, false /* bObjectIsSLIDerived */, false /* bObjectIsUObject */>
 {
 	static const IServiceLocatorInterface* Execute(const ObjectType* Object)
 	{
@@ -51,6 +64,69 @@ struct TGetObjectAsSLI<ObjectType, false /* bObjectIsSLIDerived */>
 
 ///////////////////////////////////////////////////////////////////////
 
+/**
+ * Gets many objects as IServiceLocatorInterface in turn, for batched lookups. UObjects which don't statically derive from the
+ * interface only resolve the interface's offset when the class changes from the previous object, which it rarely does.
+ */
+template<typename ObjectType,
+	bool bObjectIsSLIDerived = TPointerIsConvertibleFromTo<ObjectType, const volatile IServiceLocatorInterface>::Value,
+	bool bObjectIsUObject = TPointerIsConvertibleFromTo<ObjectType, const volatile UObject>::Value>
+struct TBatchedGetObjectAsSLI
+{
+	const IServiceLocatorInterface* Execute(const ObjectType* Object)
+	{
+		return TGetObjectAsSLI<ObjectType>::Execute(Object);
+	}
+};
+
+template<typename ObjectType>
+struct TBatchedGetObjectAsSLI<ObjectType, false /* bObjectIsSLIDerived */, true /* bObjectIsUObject */>
+{
+	const IServiceLocatorInterface* Execute(const ObjectType* Object)
+	{
+		if (Object == nullptr)
+		{
+			return nullptr;
+		}
+
+		const UClass* Class = Object->GetClass();
+		if (Class != LastClass)
+		{
+			LastClass = Class;
+			LastOffset = FServiceLocatorContainerRegistry::GetInterfaceOffset(Object);
+		}
+
+		return (LastOffset != INDEX_NONE) ? reinterpret_cast<const IServiceLocatorInterface*>((const uint8*)Object + LastOffset) : nullptr;
+	}
+
+private:
+
+	const UClass*	LastClass	= nullptr;
+	int32			LastOffset	= INDEX_NONE;
+};
+
+///////////////////////////////////////////////////////////////////////
+
+template<typename ObjectType, bool bObjectIsUObject = TPointerIsConvertibleFromTo<ObjectType, const volatile UObject>::Value>
+struct TFindAttachedContainer
+{
+	static UServiceLocatorContainer* Execute(const ObjectType* Object)
+	{
+		return nullptr;
+	}
+};
+
+template<typename ObjectType>
+struct TFindAttachedContainer<ObjectType, true /* bObjectIsUObject */>
+{
+	static UServiceLocatorContainer* Execute(const ObjectType* Object)
+	{
+		return FServiceLocatorContainerRegistry::FindAttachedContainer(Object);
+	}
+};
+
+///////////////////////////////////////////////////////////////////////
+
 template<typename ServiceType, bool bIsIInterface = TIsIInterface<ServiceType>::Value, bool bIsUInterface = TIsUInterface<ServiceType>::Value>
 struct TGetServiceClassType;
 
@@ -116,3 +192,45 @@ struct TGetServicePointer<ServiceType, false /* bIsIInterface */, true /* bIsUIn
 };
 
 ///////////////////////////////////////////////////////////////////////
+
+template<typename ServiceType, bool bIsIInterface = TIsIInterface<ServiceType>::Value, bool bIsUInterface = TIsUInterface<ServiceType>::Value>
+struct TGetServiceObject;
+
+template<typename ServiceType>
+struct TGetServiceObject<ServiceType, true /* bIsIInterface */, false /* bIsUInterface */>
+{
+	static UObject* Execute(ServiceType* Service)
+	{
+		return (Service != nullptr) ? Service->_getUObject() : nullptr;
+	}
+};
+
+template<typename ServiceType>
+struct TGetServiceObject<ServiceType, false /* bIsIInterface */, false /* bIsUInterface */>
+{
+	static UObject* Execute(ServiceType* Service)
+	{
+		return (UObject*)Service;
+	}
+};
+
+template<typename ServiceType>
+struct TGetServiceObject<ServiceType, false /* bIsIInterface */, true /* bIsUInterface */>
+{
+	static UObject* Execute(ServiceType* Service)
+	{
+		static_assert(TIsSame<ServiceType, ServiceType*>::Value, "Please use the I-prefix interface type instead of the U-prefix type!");
+		return nullptr;
+	}
+};
+
+///////////////////////////////////////////////////////////////////////
+
+// Whether ServiceType can be mapped in a UServiceLocatorContainer, i.e. it's a UObject or I-prefix interface type
+template<typename ServiceType>
+struct TIsLocatableServiceType
+{
+	enum { Value = TIsIInterface<ServiceType>::Value || (TPointerIsConvertibleFromTo<ServiceType, const volatile UObject>::Value && !TIsUInterface<ServiceType>::Value) };
+};
+
+///////////////////////////////////////////////////////////////////////
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorInjection.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+struct FServiceInjectionPoint
+{
+	// The offset of the property within its owning object
+	int32	Offset			= 0;
+
+	// The type the service is retrieved as
+	UClass*	ServiceType		= nullptr;
+
+	// (Optional) The key the service is mapped under, set with meta=(InjectService="Key")
+	FName	ServiceKey;
+
+	// Whether the property is a TScriptInterface, which also holds the service's native interface address
+	bool	bInterface		= false;
+};
+
+using FServiceInjectionPoints = TArray<FServiceInjectionPoint>;
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Resolves and caches, per class, the UPROPERTYs which are filled with services by UServiceLocatorContainer::InjectServices().
+ * A property is injected if it's marked with meta=(InjectService), and is a UObject pointer or TScriptInterface of the service type.
+ * As metadata is stripped from cooked builds, properties which must be injected there are also registered with RegisterInjectedProperty().
+ * Injection points are cached on the class's object index, and are only used on the game thread.
+ */
+class UNREALSERVICELOCATOR_API FServiceLocatorInjection
+{
+public:
+
+	/**
+	 * Gets the injection points of Class, including those of its super classes, resolving them the first time they're needed
+	 * @param	Class					The class to get the injection points of
+	 * @return	FServiceInjectionPoints	The injection points, which are empty if Class has none
+	 */
+	static const FServiceInjectionPoints& GetInjectionPoints(const UClass* Class);
+
+	/**
+	 * Resolves the injection points of Class without caching them. Must be called on the game thread, as reading metadata
+	 * may load or create a package's metadata object, and registered properties aren't synchronised.
+	 * @param	Class					The class to resolve the injection points of
+	 * @param	OutInjectionPoints		Receives the injection points
+	 */
+	static void FindInjectionPoints(const UClass* Class, FServiceInjectionPoints& OutInjectionPoints);
+
+	/**
+	 * Marks a property as injected in builds without metadata. Safe to call before the class is registered, e.g. from module startup.
+	 * @param	ClassPath		The path of the class which declares the property, e.g. /Script/MyGame.MyActor
+	 * @param	PropertyName	The name of the property
+	 * @param	ServiceKey		(Optional) The key the service is mapped under
+	 */
+	static void RegisterInjectedProperty(const FString& ClassPath, FName PropertyName, FName ServiceKey = NAME_None);
+
+	/**
+	 * Discards every cached set of injection points, so that they're resolved again the next time they're needed
+	 */
+	static void Reset();
+
+	// The metadata which marks a property as injected
+	static const FName InjectServiceMetaData;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorNativeRegistry.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "CoreMinimal.h"
+
+// Forward Declarations
+class UServiceLocatorConfig;
+struct FServiceDescriptor;
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Holds descriptors for C++ services registered with REGISTER_NATIVE_SERVICE, so that core services can be located without a
+ * UServiceLocatorConfig asset having to be loaded first. Services are registered into named groups, and containers locate
+ * the groups listed in their NativeServiceGroups ahead of the descriptors in their config, or on their own if they have none.
+ * Registrations are recorded during static initialisation, and resolved and validated on the game thread once the registering
+ * module's classes have been registered, or when they're first needed. Descriptors with errors are logged and discarded.
+ */
+class UNREALSERVICELOCATOR_API FServiceLocatorNativeRegistry
+{
+public:
+
+	using FGetServiceTypeFunction = UClass* (*)();
+	using FConfigureDescriptorFunction = void (*)(FServiceDescriptor&);
+
+	/**
+	 * Records a native service, to be resolved later. Called by REGISTER_NATIVE_SERVICE, so may run during static initialisation.
+	 * @param	Group				The group the service is registered into
+	 * @param	GetServiceType		Returns the service's class, e.g. &UMyService::StaticClass
+	 * @param	ConfigureDescriptor	(Optional) Fills in the rest of the descriptor. If no mapped types are added, the service type is mapped.
+	 *								A factory set here is rooted, and duplicated into each merged config rather than shared.
+	 */
+	static void RegisterService(const TCHAR* Group, FGetServiceTypeFunction GetServiceType, FConfigureDescriptorFunction ConfigureDescriptor);
+
+	/**
+	 * Resolves and validates every service registered since the last call
+	 */
+	static void ProcessPendingRegistrations();
+
+	/**
+	 * Gets the config a container should locate services from, i.e. the services of Groups followed by the descriptors of Config.
+	 * Descriptors in Config replace native ones for the same type and key. Merged configs are shared between containers.
+	 * @param	Config					(Optional) The container's config
+	 * @param	Groups					The groups of native services to merge in
+	 * @return	UServiceLocatorConfig*	The merged config, or Config itself if none of the groups have any services
+	 */
+	static UServiceLocatorConfig* GetMergedConfig(UServiceLocatorConfig* Config, const TArray<FName>& Groups);
+
+	/**
+	 * Makes every merged config be rebuilt the next time it's needed, e.g. after a config has been edited
+	 */
+	static void InvalidateMergedConfigs();
+
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+struct FNativeServiceRegistration
+{
+	FNativeServiceRegistration(const TCHAR* Group, FServiceLocatorNativeRegistry::FGetServiceTypeFunction GetServiceType, FServiceLocatorNativeRegistry::FConfigureDescriptorFunction ConfigureDescriptor = nullptr)
+	{
+		FServiceLocatorNativeRegistry::RegisterService(Group, GetServiceType, ConfigureDescriptor);
+	}
+};
+
+/**
+ * Registers a C++ service into a group of native services, at file scope in a .cpp, e.g.
+ *
+ *	REGISTER_NATIVE_SERVICE(TEXT("World"), UMyService, [](FServiceDescriptor& Descriptor)
+ *	{
+ *		Descriptor.MappedTypes.Emplace(UMyServiceInterface::StaticClass());
+ *	});
+ *
+ * Named with __COUNTER__ rather than __LINE__, so that registrations on the same line of different files don't collide in unity builds.
+ */
+#define REGISTER_NATIVE_SERVICE(Group, ServiceType, ...) \
+	static FNativeServiceRegistration PREPROCESSOR_JOIN(NativeServiceRegistration_, __COUNTER__)(Group, &ServiceType::StaticClass, ##__VA_ARGS__)
+
+///////////////////////////////////////////////////////////////////////////
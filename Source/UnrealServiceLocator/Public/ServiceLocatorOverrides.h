@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorOverrides.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "CoreMinimal.h"
+
+// UnrealServiceLocator
+#include "ServiceLocatorContainer.h"
+#include "ServiceLocatorHelpers.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+#if SERVICE_LOCATOR_OVERRIDES
+
+/**
+ * Overrides the service mapped to a type in a container for the lifetime of the scope, e.g. to swap in a mock for a test
+ */
+template<typename ServiceType>
+class TScopedServiceOverride : public FNoncopyable
+{
+public:
+
+	TScopedServiceOverride(UServiceLocatorContainer* InContainer, UObject* InOverrideInstance)
+		: Container(InContainer)
+		, OverrideInstance(InOverrideInstance)
+	{
+		if (Container.IsValid())
+		{
+			Container->AddServiceOverride(TGetServiceClassType<ServiceType>::Execute(), OverrideInstance.Get());
+		}
+	}
+
+	~TScopedServiceOverride()
+	{
+		if (Container.IsValid())
+		{
+			Container->RemoveServiceOverride(TGetServiceClassType<ServiceType>::Execute(), OverrideInstance.Get());
+		}
+	}
+
+private:
+
+	TWeakObjectPtr<UServiceLocatorContainer>	Container;
+	TWeakObjectPtr<UObject>						OverrideInstance;
+
+};
+
+#endif // SERVICE_LOCATOR_OVERRIDES
+
+///////////////////////////////////////////////////////////////////////////
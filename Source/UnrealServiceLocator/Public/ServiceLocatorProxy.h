@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorProxy.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/Function.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * A multi-producer, single-consumer queue of calls which are enqueued from any thread and drained on the game thread
+ */
+class UNREALSERVICELOCATOR_API FServiceCallQueue
+{
+public:
+
+	/**
+	 * Queues a call to be run on the game thread the next time the queue is drained. Safe to call from any thread.
+	 * @param	Call			The call to queue
+	 */
+	void Enqueue(TUniqueFunction<void()>&& Call);
+
+	/**
+	 * Runs every queued call, in the order they were queued. Must be called on the game thread.
+	 * @return	int32			The number of calls run
+	 */
+	int32 Drain();
+
+	FORCEINLINE bool IsEmpty() const { return Calls.IsEmpty(); }
+
+	/**
+	 * Sets a function called whenever a call is queued into an empty queue, on the queueing thread. Must be set before any calls are queued.
+	 */
+	FORCEINLINE void SetOnFirstCallQueued(TFunction<void()>&& InOnFirstCallQueued) { OnFirstCallQueued = MoveTemp(InOnFirstCallQueued); }
+
+private:
+
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Calls;
+
+	// Set by the first call queued since the queue was last drained
+	FThreadSafeBool bHasQueuedCalls;
+	TFunction<void()> OnFirstCallQueued;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * A handle to a game thread only service which can be passed to worker threads.
+ * Calls are queued and run against the service on the game thread when its container next ticks.
+ */
+template<typename ServiceType>
+class TQueuedServiceProxy
+{
+public:
+
+	TQueuedServiceProxy() = default;
+
+	TQueuedServiceProxy(ServiceType* InService, UObject* InServiceObject, const TSharedRef<FServiceCallQueue, ESPMode::ThreadSafe>& InQueue)
+		: Service(InService)
+		, ServiceObject(InServiceObject)
+		, Queue(InQueue)
+	{
+	}
+
+	FORCEINLINE bool IsValid() const { return (Service != nullptr) && Queue.IsValid(); }
+
+	/**
+	 * Queues a call to be run against the service on the game thread. Safe to call from any thread.
+	 * The call is dropped if the service has been destroyed by the time the queue is drained.
+	 * @param	Call			A callable taking a ServiceType&
+	 */
+	template<typename FunctorType>
+	void Enqueue(FunctorType&& Call) const
+	{
+		if (!IsValid())
+			return;
+
+		Queue->Enqueue([Service = Service, WeakServiceObject = ServiceObject, Call = Forward<FunctorType>(Call)]() mutable
+		{
+			if (WeakServiceObject.IsValid())
+			{
+				Call(*Service);
+			}
+		});
+	}
+
+private:
+
+	ServiceType*										Service = nullptr;
+	TWeakObjectPtr<UObject>								ServiceObject;
+	TSharedPtr<FServiceCallQueue, ESPMode::ThreadSafe>	Queue;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorStaticContainer.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "CoreMinimal.h"
+#include "Templates/IntegerSequence.h"
+#include "Templates/Tuple.h"
+#include "UObject/GCObject.h"
+
+// UnrealServiceLocator
+#include "ServiceLocatorContainer.h"
+#include "ServiceLocatorHelpers.h"
+
+///////////////////////////////////////////////////////////////////////
+
+template<typename ServiceType, typename... ServiceTypes>
+struct TStaticServiceIndex;
+
+template<typename ServiceType>
+struct TStaticServiceIndex<ServiceType>
+{
+	static_assert(TIsSame<ServiceType, ServiceType*>::Value, "ServiceType isn't one of the services held by this TStaticServiceContainer!");
+	enum { Value = 0 };
+};
+
+template<typename ServiceType, typename... OtherServiceTypes>
+struct TStaticServiceIndex<ServiceType, ServiceType, OtherServiceTypes...>
+{
+	enum { Value = 0 };
+};
+
+template<typename ServiceType, typename FirstServiceType, typename... OtherServiceTypes>
+struct TStaticServiceIndex<ServiceType, FirstServiceType, OtherServiceTypes...>
+{
+	enum { Value = 1 + TStaticServiceIndex<ServiceType, OtherServiceTypes...>::Value };
+};
+
+///////////////////////////////////////////////////////////////////////
+
+template<typename ServiceType, bool bIsLocatable = TIsLocatableServiceType<ServiceType>::Value>
+struct TStaticServiceRegistration;
+
+template<typename ServiceType>
+struct TStaticServiceRegistration<ServiceType, true /* bIsLocatable */>
+{
+	static void Register(UServiceLocatorContainer& Container, ServiceType* Service)
+	{
+		if (Service != nullptr)
+		{
+			Container.RegisterService(TGetServiceClassType<ServiceType>::Execute(), TGetServiceObject<ServiceType>::Execute(Service));
+		}
+	}
+
+	static void Unregister(UServiceLocatorContainer& Container, ServiceType* Service)
+	{
+		if (Service != nullptr)
+		{
+			Container.UnregisterService(TGetServiceClassType<ServiceType>::Execute(), TGetServiceObject<ServiceType>::Execute(Service));
+		}
+	}
+
+	static void AddReferencedObject(FReferenceCollector& Collector, ServiceType*& Service, const UObject* ReferencingObject)
+	{
+		// Interface services are referenced through their object, and cleared along with it if it's eliminated
+		UObject* ServiceObject = TGetServiceObject<ServiceType>::Execute(Service);
+		if (ServiceObject != nullptr)
+		{
+			Collector.AddReferencedObject(ServiceObject, ReferencingObject);
+			if (ServiceObject == nullptr)
+			{
+				Service = nullptr;
+			}
+		}
+	}
+};
+
+template<typename ServiceType>
+struct TStaticServiceRegistration<ServiceType, false /* bIsLocatable */>
+{
+	// Plain C++ services can only be retrieved from the static container
+	static void Register(UServiceLocatorContainer& Container, ServiceType* Service) {}
+	static void Unregister(UServiceLocatorContainer& Container, ServiceType* Service) {}
+	static void AddReferencedObject(FReferenceCollector& Collector, ServiceType*& Service, const UObject* ReferencingObject) {}
+};
+
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * A container for a fixed set of natively known services, where Get<ServiceType>() resolves to a tuple slot at compile time.
+ * Services may be UObjects, I-prefix interfaces or plain C++ types. The UObject and interface services can also be
+ * registered with a UServiceLocatorContainer, so that they can still be retrieved through the dynamic GetService() path.
+ * Registering doesn't keep the UObject and interface services alive, so the container's host must report them to the garbage
+ * collector with AddReferencedObjects(), e.g. from its own AddReferencedObjects(), or use TGCStaticServiceContainer.
+ */
+template<typename... ServiceTypes>
+class TStaticServiceContainer
+{
+public:
+
+	/**
+	 * Returns the service specified by the ServiceType template parameter
+	 * @return	ServiceType*	The service instance
+	 */
+	template<typename ServiceType>
+	FORCEINLINE ServiceType* Get() const
+	{
+		return Services.template Get<TStaticServiceIndex<ServiceType, ServiceTypes...>::Value>();
+	}
+
+	/**
+	 * Sets the service specified by the ServiceType template parameter. Containers this has already been registered with
+	 * aren't updated, so services should be set before calling RegisterWith().
+	 * @param	Service			The service instance
+	 */
+	template<typename ServiceType>
+	FORCEINLINE void Set(ServiceType* Service)
+	{
+		Services.template Get<TStaticServiceIndex<ServiceType, ServiceTypes...>::Value>() = Service;
+	}
+
+	/**
+	 * Maps every UObject and interface service held by this container in Container, under its static type
+	 * @param	Container		The dynamic container to register with
+	 */
+	void RegisterWith(UServiceLocatorContainer& Container) const
+	{
+		RegisterWithInternal(Container, TMakeIntegerSequence<uint32, sizeof...(ServiceTypes)>());
+	}
+
+	/**
+	 * Removes the mappings added by RegisterWith(), unless they have since been displaced
+	 * @param	Container		The dynamic container to unregister from
+	 */
+	void UnregisterFrom(UServiceLocatorContainer& Container) const
+	{
+		UnregisterFromInternal(Container, TMakeIntegerSequence<uint32, sizeof...(ServiceTypes)>());
+	}
+
+	/**
+	 * Reports every UObject and interface service held by this container to the garbage collector. Services which are
+	 * destroyed are cleared, rather than left dangling.
+	 * @param	Collector			The collector to report the services to
+	 * @param	ReferencingObject	(Optional) The object holding this container
+	 */
+	void AddReferencedObjects(FReferenceCollector& Collector, const UObject* ReferencingObject = nullptr)
+	{
+		AddReferencedObjectsInternal(Collector, ReferencingObject, TMakeIntegerSequence<uint32, sizeof...(ServiceTypes)>());
+	}
+
+private:
+
+	template<uint32... Indices>
+	void RegisterWithInternal(UServiceLocatorContainer& Container, TIntegerSequence<uint32, Indices...>) const
+	{
+		int32 Expansion[] = { 0, (TStaticServiceRegistration<ServiceTypes>::Register(Container, Services.template Get<Indices>()), 0)... };
+		(void)Expansion;
+	}
+
+	template<uint32... Indices>
+	void UnregisterFromInternal(UServiceLocatorContainer& Container, TIntegerSequence<uint32, Indices...>) const
+	{
+		int32 Expansion[] = { 0, (TStaticServiceRegistration<ServiceTypes>::Unregister(Container, Services.template Get<Indices>()), 0)... };
+		(void)Expansion;
+	}
+
+	template<uint32... Indices>
+	void AddReferencedObjectsInternal(FReferenceCollector& Collector, const UObject* ReferencingObject, TIntegerSequence<uint32, Indices...>)
+	{
+		int32 Expansion[] = { 0, (TStaticServiceRegistration<ServiceTypes>::AddReferencedObject(Collector, Services.template Get<Indices>(), ReferencingObject), 0)... };
+		(void)Expansion;
+	}
+
+	TTuple<ServiceTypes*...> Services;
+
+};
+
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * A TStaticServiceContainer which keeps its UObject and interface services alive itself, for hosts which aren't UObjects,
+ * e.g. a plain C++ system
+ */
+template<typename... ServiceTypes>
+class TGCStaticServiceContainer : public TStaticServiceContainer<ServiceTypes...>, public FGCObject
+{
+public:
+
+	//////////////////////////////////////////////
+	// Overridden Functions - FGCObject
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		TStaticServiceContainer<ServiceTypes...>::AddReferencedObjects(Collector);
+	}
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("TGCStaticServiceContainer");
+	}
+
+};
+
+///////////////////////////////////////////////////////////////////////
@@ -6,14 +6,18 @@
 
 // Engine
 #include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
 #include "UObject/ObjectMacros.h"
 #include "Templates/SubclassOf.h"
+#include "UObject/SoftObjectPtr.h"
+#include "GameplayTagContainer.h"
 
 // UnrealServiceLocator
 #include "ServiceLocatorTypes.generated.h"
 
 // Forward Declarations
 class UInterface;
+class UServiceFactory;
 
 ///////////////////////////////////////////////////////////////////////////
 
@@ -38,6 +42,171 @@ enum class EServiceLocationBehaviour : uint8
 
 ///////////////////////////////////////////////////////////////////////////
 
+UENUM()
+enum class EServiceRecoveryBehaviour : uint8
+{
+	// [None] will unmap the service when it's destroyed, so any call to GetService() for its types will return a nullptr
+	None,
+
+	// [Immediate] will unmap the service when it's destroyed, then locate or create it again (according to the
+	// LocateBehaviour) when the container next ticks, which is later in the same frame. A component service destroyed on
+	// its own, rather than with its owner, is only noticed when the container next ticks or looks it up, or before the next GC.
+	Immediate,
+
+	// [OnNextLookup] will unmap the service when it's destroyed, then locate or create it again (according to the
+	// LocateBehaviour) the next time GetOrRecoverService() is called for one of its types
+	OnNextLookup
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+UENUM()
+enum class EServiceThreadAffinity : uint8
+{
+	// [AnyThread] services may be retrieved and used from any thread
+	AnyThread,
+
+	// [GameThreadOnly] services may only be retrieved and used on the game thread.
+	// Other threads should use a queued proxy, obtained on the game thread via GetQueuedServiceProxy()
+	GameThreadOnly
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+UENUM()
+enum class EServiceState : uint8
+{
+	// [Unavailable] means that no service is mapped to the type, nor will there be one once location completes
+	Unavailable,
+
+	// [Pending] means that the container is still locating services asynchronously, and the type may become available
+	Pending,
+
+	// [Ready] means that a service is mapped to the type, and GetService() will return it
+	Ready
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EServiceNetModeFlags : uint8
+{
+	None			= 0 UMETA(Hidden),
+	Standalone		= 1 << 0,
+	DedicatedServer	= 1 << 1,
+	ListenServer	= 1 << 2,
+	Client			= 1 << 3
+};
+ENUM_CLASS_FLAGS(EServiceNetModeFlags);
+
+///////////////////////////////////////////////////////////////////////////
+
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EServiceBuildConfigurationFlags : uint8
+{
+	None			= 0 UMETA(Hidden),
+	Debug			= 1 << 0,
+	Development		= 1 << 1,
+	Test			= 1 << 2,
+	Shipping		= 1 << 3
+};
+ENUM_CLASS_FLAGS(EServiceBuildConfigurationFlags);
+
+///////////////////////////////////////////////////////////////////////////
+
+// Conditions under which a descriptor is active. A container evaluates them once, before locating services, and skips inactive descriptors.
+USTRUCT()
+struct FServiceConditions
+{
+	GENERATED_BODY()
+
+public:
+
+	// (Optional) The net modes the service is active in. None means every net mode.
+	UPROPERTY(EditAnywhere, meta = (Bitmask, BitmaskEnum = "EServiceNetModeFlags"))
+	int32				NetModes				= 0;
+
+	// (Optional) The build configurations the service is active in. None means every build configuration.
+	UPROPERTY(EditAnywhere, meta = (Bitmask, BitmaskEnum = "EServiceBuildConfigurationFlags"))
+	int32				BuildConfigurations		= 0;
+
+	// (Optional) The platforms the service is active on, by ini platform name, e.g. Windows or Linux. Empty means every platform.
+	UPROPERTY(EditAnywhere)
+	TArray<FString>		Platforms;
+
+	// (Optional) Feature flags which must all be enabled. A feature is enabled by -Feature on the command line, or a non-zero console variable named Feature.
+	UPROPERTY(EditAnywhere)
+	TArray<FName>		RequiredFeatures;
+
+	// (Optional) Feature flags which must all be disabled
+	UPROPERTY(EditAnywhere)
+	TArray<FName>		ExcludedFeatures;
+
+	// (Optional) Tags which the map's world settings must all have
+	UPROPERTY(EditAnywhere)
+	TArray<FName>		RequiredMapTags;
+
+	// (Optional) Tags which the map's world settings mustn't have
+	UPROPERTY(EditAnywhere)
+	TArray<FName>		ExcludedMapTags;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+// How the container ticks a service which implements IServiceTickInterface
+USTRUCT()
+struct FServiceTickSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	// Services with a lower priority tick first, once their prerequisites have ticked
+	UPROPERTY(EditAnywhere)
+	int32							Priority		= 0;
+
+	// (Optional) Types whose services must tick before this one, regardless of priority
+	UPROPERTY(EditAnywhere, meta = (AllowAbstract))
+	TArray<TSoftClassPtr<UObject>>	Prerequisites;
+
+	// Whether the service's tick is thread safe, so that it may run on a worker thread, in parallel with other such services
+	UPROPERTY(EditAnywhere)
+	bool							bTickInParallel	= false;
+
+	// (Optional) The time, in milliseconds, the service's tick may take before a warning is logged. Zero means no budget.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float							BudgetMs		= 0.0f;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+// How the container spawns an actor service which it has to create
+USTRUCT()
+struct FServiceSpawnSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	// The transform the actor is spawned with
+	UPROPERTY(EditAnywhere)
+	FTransform								Transform;
+
+	// Whether the actor is owned by the actor this container belongs to, e.g. so that it's relevant to the same player
+	UPROPERTY(EditAnywhere)
+	bool									bOwnedByContainerActor	= false;
+
+	// (Optional) The level the actor is spawned into, which must already be loaded. Defaults to the persistent level.
+	UPROPERTY(EditAnywhere)
+	TSoftObjectPtr<UWorld>					Level;
+
+	// How the actor is spawned if it collides with something at its spawn transform
+	UPROPERTY(EditAnywhere)
+	ESpawnActorCollisionHandlingMethod		CollisionHandling		= ESpawnActorCollisionHandlingMethod::Undefined;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
 USTRUCT()
 struct FServiceDescriptor
 {
@@ -45,22 +214,65 @@ struct FServiceDescriptor
 
 public:
 
-	// The concrete type to locate
+	// The concrete type to locate. Soft, so that loading a config doesn't load every service class it references.
 	UPROPERTY(EditAnywhere)
-	UClass*						ServiceType		= nullptr;
+	TSoftClassPtr<UObject>			ServiceType;
 
 	// (Optional) Types to map to this service (both concrete and abstract classes allowed)
 	UPROPERTY(EditAnywhere, meta = (AllowAbstract))
-	TArray<UClass*>				MappedTypes;
+	TArray<TSoftClassPtr<UObject>>	MappedTypes;
+
+	// (Optional) The key this service is mapped under, so that several services can be mapped to the same type, e.g. one per team.
+	// Keyed services are retrieved by key, and never displace the unkeyed service of the same type.
+	UPROPERTY(EditAnywhere)
+	FName						ServiceKey;
+
+	// (Optional) A gameplay tag to key this service by, which takes precedence over ServiceKey
+	UPROPERTY(EditAnywhere)
+	FGameplayTag				ServiceTag;
 
 	// The behaviour used for locating this particular service
 	UPROPERTY(EditAnywhere)
 	EServiceLocationBehaviour	LocateBehaviour	= EServiceLocationBehaviour::CreateIfNotFound;
 
+	// What the container does if the service is destroyed while it's mapped
+	UPROPERTY(EditAnywhere)
+	EServiceRecoveryBehaviour	RecoveryBehaviour	= EServiceRecoveryBehaviour::None;
+
 	// Whether the service will only be located in non-shipping builds
 	UPROPERTY(EditAnywhere)
 	bool						bDebugOnly		= false;
 
+	// (Optional) Further conditions under which the service is located, e.g. net mode, platform or feature flags
+	UPROPERTY(EditAnywhere)
+	FServiceConditions			Conditions;
+
+	// Whether the service is always located synchronously, even when the container is locating services asynchronously
+	UPROPERTY(EditAnywhere)
+	bool						bCritical		= false;
+
+	// The threads this service may be retrieved from, which is checked in non-shipping builds
+	UPROPERTY(EditAnywhere)
+	EServiceThreadAffinity		ThreadAffinity	= EServiceThreadAffinity::AnyThread;
+
+	// How the service is ticked by the container, if it implements IServiceTickInterface
+	UPROPERTY(EditAnywhere)
+	FServiceTickSettings		TickSettings;
+
+	// How the service is spawned if it's an actor which has to be created, and no factory is set
+	UPROPERTY(EditAnywhere)
+	FServiceSpawnSettings		SpawnSettings;
+
+	// (Optional) The factory used to create this service if it can't be located, instead of the container's default creation
+	UPROPERTY(EditAnywhere, Instanced)
+	UServiceFactory*			Factory			= nullptr;
+
+	// The concrete type to locate, or null if it's unset or not loaded
+	FORCEINLINE UClass* GetServiceType() const { return ServiceType.Get(); }
+
+	// The key this service is mapped under, or NAME_None if it's unkeyed
+	FORCEINLINE FName GetServiceKey() const { return ServiceTag.IsValid() ? ServiceTag.GetTagName() : ServiceKey; }
+
 };
 
 ///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,43 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorWorldRegistry.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "CoreMinimal.h"
+
+// Forward Declarations
+class UServiceLocatorContainer;
+class UWorld;
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Maps each world to its root container, i.e. the container holding its world-wide services, so that world-wide services can
+ * be found in constant time without going through the game state or game mode. Each world in the process has its own root.
+ * Registrations are held on the world's object index, and are removed automatically when the world is destroyed.
+ */
+class UNREALSERVICELOCATOR_API FServiceLocatorWorldRegistry
+{
+public:
+
+	/**
+	 * Makes Container the root container of World, replacing any previous root
+	 */
+	static void RegisterRootContainer(UWorld* World, UServiceLocatorContainer* Container);
+
+	/**
+	 * Removes Container as the root container of World, if it is the root
+	 */
+	static void UnregisterRootContainer(UWorld* World, UServiceLocatorContainer* Container);
+
+	/**
+	 * Gets the root container of World
+	 * @return	UServiceLocatorContainer*	The root container, or null if World has none
+	 */
+	static UServiceLocatorContainer* GetRootContainer(const UWorld* World);
+
+};
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,41 @@
+///////////////////////////////////////////////////////////////////////////
+// ServicePoolInterface.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "UObject/Interface.h"
+
+// UnrealServiceLocator
+#include "ServicePoolInterface.generated.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UNREALSERVICELOCATOR_API UServicePoolInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class UNREALSERVICELOCATOR_API IServicePoolInterface
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Called on the game thread when the service is released into a pool, after it has been shut down.
+	 * Should drop any state and references from its previous use, so that nothing from it leaks into the next.
+	 */
+	virtual void ReleaseToPool() = 0;
+
+	/**
+	 * Called on the game thread when the service is reused from a pool, before it's handed to the container which needs it.
+	 * Should put the service into the same state as a newly created instance.
+	 */
+	virtual void ReuseFromPool() = 0;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
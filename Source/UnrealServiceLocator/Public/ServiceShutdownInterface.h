@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceShutdownInterface.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "UObject/Interface.h"
+
+// UnrealServiceLocator
+#include "ServiceShutdownInterface.generated.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UNREALSERVICELOCATOR_API UServiceShutdownInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class UNREALSERVICELOCATOR_API IServiceShutdownInterface
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Called when the container that created this service shuts down, before the service is destroyed.
+	 * Object services whose descriptor has AnyThread affinity may have this called from a worker thread,
+	 * in parallel with other such services.
+	 */
+	virtual void ShutdownService() = 0;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceTickInterface.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "UObject/Interface.h"
+
+// UnrealServiceLocator
+#include "ServiceTickInterface.generated.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UNREALSERVICELOCATOR_API UServiceTickInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class UNREALSERVICELOCATOR_API IServiceTickInterface
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Called every frame by the container that located or created this service, in the order set by its descriptor's TickSettings.
+	 * Services whose TickSettings have bTickInParallel set may have this called from a worker thread,
+	 * in parallel with other such services.
+	 * @param	DeltaTime		The time since the last tick, in seconds
+	 */
+	virtual void TickService(float DeltaTime) = 0;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceWarmUpInterface.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "UObject/Interface.h"
+
+// UnrealServiceLocator
+#include "ServiceWarmUpInterface.generated.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UNREALSERVICELOCATOR_API UServiceWarmUpInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class UNREALSERVICELOCATOR_API IServiceWarmUpInterface
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Called once on a worker thread, in parallel with other services, after the container that located or created this service
+	 * has finished locating services. Intended for expensive one-off preparation, e.g. building lookup tables, which would
+	 * otherwise hitch the first time the service is used. Mustn't touch the world or other game thread only state.
+	 */
+	virtual void WarmUpService() = 0;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,7 @@ public class UnrealServiceLocator : ModuleRules
 				"Core",
 				"CoreUObject",
 				"Engine",
+				"GameplayTags",
 			}
 		);
 	}
@@ -0,0 +1,496 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorBenchmark.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocator
+#include "ServiceLocatorBenchmark.h"
+#include "ServiceLocatorConfig.h"
+#include "ServiceLocatorContainer.h"
+#include "ServiceLocatorContainerRegistry.h"
+#include "ServiceLocatorTypes.h"
+
+// Engine
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectArray.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+AServiceLocatorBenchmarkActor::AServiceLocatorBenchmarkActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Container = CreateDefaultSubobject<UServiceLocatorContainer>(TEXT("Container"));
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+AServiceLocatorBenchmarkPlainActor::AServiceLocatorBenchmarkPlainActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Container = CreateDefaultSubobject<UServiceLocatorContainer>(TEXT("Container"));
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorBenchmark_Private
+{
+
+	TAutoConsoleVariable<float> CVarMaxSpawnMicrosecondsPerActor(
+		TEXT("ServiceLocator.Benchmark.MaxSpawnMicrosecondsPerActor"),
+		0.0f,
+		TEXT("Regression threshold for ServiceLocator.Benchmark.Spawn: the maximum time to spawn an actor and locate its services, in microseconds. 0 disables the check."));
+
+	TAutoConsoleVariable<int32> CVarMaxBytesPerActor(
+		TEXT("ServiceLocator.Benchmark.MaxBytesPerActor"),
+		0,
+		TEXT("Regression threshold for ServiceLocator.Benchmark.Spawn: the maximum physical memory used per actor, in bytes. 0 disables the check."));
+
+	TAutoConsoleVariable<float> CVarMaxGarbageCollectionMilliseconds(
+		TEXT("ServiceLocator.Benchmark.MaxGarbageCollectionMilliseconds"),
+		0.0f,
+		TEXT("Regression threshold for ServiceLocator.Benchmark.Spawn: the maximum time to collect the destroyed actors and services, in milliseconds. 0 disables the check."));
+
+	///////////////////////////////////////////////////////////////////////////
+
+	struct FSpawnBenchmarkResult
+	{
+		int32	NumActors						= 0;
+		int32	NumComponentServices			= 0;
+		int32	NumObjectServices				= 0;
+		double	SpawnMilliseconds				= 0.0;
+		double	LocateMilliseconds				= 0.0;
+		double	ShutdownMilliseconds			= 0.0;
+		double	GarbageCollectionMilliseconds	= 0.0;
+		int64	BytesPerActor					= 0;
+		float	ObjectsPerActor					= 0.0f;
+	};
+
+	///////////////////////////////////////////////////////////////////////////
+
+	UServiceLocatorConfig* CreateBenchmarkConfig(int32 NumComponentServices, int32 NumObjectServices)
+	{
+		UClass* const ComponentServiceTypes[] =
+		{
+			UServiceLocatorBenchmarkComponentA::StaticClass(),
+			UServiceLocatorBenchmarkComponentB::StaticClass(),
+			UServiceLocatorBenchmarkComponentC::StaticClass(),
+			UServiceLocatorBenchmarkComponentD::StaticClass(),
+		};
+
+		UClass* const ObjectServiceTypes[] =
+		{
+			UServiceLocatorBenchmarkObjectA::StaticClass(),
+			UServiceLocatorBenchmarkObjectB::StaticClass(),
+			UServiceLocatorBenchmarkObjectC::StaticClass(),
+			UServiceLocatorBenchmarkObjectD::StaticClass(),
+		};
+
+		UServiceLocatorConfig* Config = NewObject<UServiceLocatorConfig>(GetTransientPackage(), NAME_None, RF_Transient);
+
+		auto AddDescriptor = [Config](UClass* ServiceType)
+		{
+			FServiceDescriptor& ServiceDescriptor = Config->ServiceDescriptors.AddDefaulted_GetRef();
+			ServiceDescriptor.ServiceType = TSoftClassPtr<UObject>(ServiceType);
+			ServiceDescriptor.MappedTypes.Emplace(ServiceType);
+			ServiceDescriptor.LocateBehaviour = EServiceLocationBehaviour::CreateIfNotFound;
+		};
+
+		for (int32 Index = 0; Index < NumComponentServices; ++Index)
+		{
+			AddDescriptor(ComponentServiceTypes[Index]);
+		}
+
+		for (int32 Index = 0; Index < NumObjectServices; ++Index)
+		{
+			AddDescriptor(ObjectServiceTypes[Index]);
+		}
+
+		return Config;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	bool CheckThreshold(const TCHAR* Measurement, double Value, double Threshold, TArray<FString>& OutRegressions)
+	{
+		if ((Threshold > 0.0) && (Value > Threshold))
+		{
+			OutRegressions.Emplace(FString::Printf(TEXT("Regression in %s, %.3f exceeds threshold of %.3f"), Measurement, Value, Threshold));
+			return false;
+		}
+
+		return true;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	void WriteResult(const FSpawnBenchmarkResult& Result)
+	{
+		const FString ResultsPath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("ServiceLocator"), TEXT("SpawnBenchmark.csv"));
+
+		FString Output;
+		if (!IFileManager::Get().FileExists(*ResultsPath))
+		{
+			Output += TEXT("Actors,ComponentServices,ObjectServices,SpawnMs,LocateMs,ShutdownMs,GCMs,BytesPerActor,ObjectsPerActor") LINE_TERMINATOR;
+		}
+
+		Output += FString::Printf(TEXT("%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%lld,%.2f") LINE_TERMINATOR,
+			Result.NumActors, Result.NumComponentServices, Result.NumObjectServices,
+			Result.SpawnMilliseconds, Result.LocateMilliseconds, Result.ShutdownMilliseconds, Result.GarbageCollectionMilliseconds,
+			Result.BytesPerActor, Result.ObjectsPerActor);
+
+		FFileHelper::SaveStringToFile(Output, *ResultsPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Spawns and destroys the actors, and checks the measurements against the regression threshold CVars
+	 * @param	OutRegressions	Receives a message per threshold which was exceeded
+	 * @return	bool			Whether every threshold was met
+	 */
+	bool RunSpawnBenchmark(UWorld* World, int32 NumActors, int32 NumComponentServices, int32 NumObjectServices, TArray<FString>& OutRegressions)
+	{
+		check(World != nullptr);
+
+		FSpawnBenchmarkResult Result;
+		Result.NumActors			= FMath::Max(NumActors, 1);
+		Result.NumComponentServices	= FMath::Clamp(NumComponentServices, 0, 4);
+		Result.NumObjectServices	= FMath::Clamp(NumObjectServices, 0, 4);
+
+		UServiceLocatorConfig* Config = CreateBenchmarkConfig(Result.NumComponentServices, Result.NumObjectServices);
+		Config->AddToRoot();
+
+		// Start from a clean heap, so that the measurements only cover what the benchmark allocates
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+		const uint64 UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+		const int32 NumObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+		TArray<AServiceLocatorBenchmarkActor*> Actors;
+		Actors.Reserve(Result.NumActors);
+
+		FActorSpawnParameters ActorSpawnParameters;
+		ActorSpawnParameters.ObjectFlags = RF_Transient;
+		ActorSpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		for (int32 Index = 0; Index < Result.NumActors; ++Index)
+		{
+			double StartTime = FPlatformTime::Seconds();
+			AServiceLocatorBenchmarkActor* Actor = World->SpawnActor<AServiceLocatorBenchmarkActor>(ActorSpawnParameters);
+			Result.SpawnMilliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			if (Actor == nullptr)
+			{
+				continue;
+			}
+
+			StartTime = FPlatformTime::Seconds();
+			Actor->Container->SetConfig(Config);
+			Actor->Container->LocateAndCreateServices();
+			Result.LocateMilliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			Actors.Add(Actor);
+		}
+
+		const uint64 UsedPhysicalAfter = FPlatformMemory::GetStats().UsedPhysical;
+		const int32 NumObjectsAfter = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+		const int32 NumSpawned = FMath::Max(Actors.Num(), 1);
+		Result.BytesPerActor = ((int64)UsedPhysicalAfter - (int64)UsedPhysicalBefore) / NumSpawned;
+		Result.ObjectsPerActor = (float)(NumObjectsAfter - NumObjectsBefore) / NumSpawned;
+
+		const double ShutdownStartTime = FPlatformTime::Seconds();
+		for (AServiceLocatorBenchmarkActor* Actor : Actors)
+		{
+			Actor->Container->ShutdownServices();
+			Actor->Destroy();
+		}
+		Result.ShutdownMilliseconds = (FPlatformTime::Seconds() - ShutdownStartTime) * 1000.0;
+
+		Actors.Empty();
+		Config->RemoveFromRoot();
+
+		const double GarbageCollectionStartTime = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		Result.GarbageCollectionMilliseconds = (FPlatformTime::Seconds() - GarbageCollectionStartTime) * 1000.0;
+
+		UE_LOG(LogUnrealServiceLocator, Display, TEXT("ServiceLocator.Benchmark.Spawn: %d actors with %d component and %d object services. Spawn %.3fms, Locate %.3fms, Shutdown %.3fms, GC %.3fms, %lld bytes and %.2f objects per actor"),
+			Result.NumActors, Result.NumComponentServices, Result.NumObjectServices,
+			Result.SpawnMilliseconds, Result.LocateMilliseconds, Result.ShutdownMilliseconds, Result.GarbageCollectionMilliseconds,
+			Result.BytesPerActor, Result.ObjectsPerActor);
+
+		WriteResult(Result);
+
+		const double MicrosecondsPerActor = ((Result.SpawnMilliseconds + Result.LocateMilliseconds) * 1000.0) / NumSpawned;
+
+		bool bPassed = true;
+		bPassed &= CheckThreshold(TEXT("spawn time per actor (us)"), MicrosecondsPerActor, CVarMaxSpawnMicrosecondsPerActor.GetValueOnGameThread(), OutRegressions);
+		bPassed &= CheckThreshold(TEXT("memory per actor (bytes)"), (double)Result.BytesPerActor, (double)CVarMaxBytesPerActor.GetValueOnGameThread(), OutRegressions);
+		bPassed &= CheckThreshold(TEXT("garbage collection time (ms)"), Result.GarbageCollectionMilliseconds, CVarMaxGarbageCollectionMilliseconds.GetValueOnGameThread(), OutRegressions);
+		return bPassed;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	void RunSpawnBenchmarkCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr)
+		{
+			UE_LOG(LogUnrealServiceLocator, Error, TEXT("ServiceLocator.Benchmark.Spawn: No world to spawn into"));
+			return;
+		}
+
+		const int32 NumActors				= (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 1000;
+		const int32 NumComponentServices	= (Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 2;
+		const int32 NumObjectServices		= (Args.Num() > 2) ? FCString::Atoi(*Args[2]) : 2;
+
+		TArray<FString> Regressions;
+		RunSpawnBenchmark(World, NumActors, NumComponentServices, NumObjectServices, Regressions);
+
+		for (const FString& Regression : Regressions)
+		{
+			UE_LOG(LogUnrealServiceLocator, Error, TEXT("ServiceLocator.Benchmark.Spawn: %s"), *Regression);
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	struct FLookupBenchmarkResult
+	{
+		int32	NumActors					= 0;
+		int32	NumIterations				= 0;
+		double	CastNanoseconds				= 0.0;
+		double	StaticNanoseconds			= 0.0;
+		double	CachedOffsetNanoseconds		= 0.0;
+		double	AttachedNanoseconds			= 0.0;
+		double	BatchedNanoseconds			= 0.0;
+	};
+
+	///////////////////////////////////////////////////////////////////////////
+
+	void WriteResult(const FLookupBenchmarkResult& Result)
+	{
+		const FString ResultsPath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("ServiceLocator"), TEXT("LookupBenchmark.csv"));
+
+		FString Output;
+		if (!IFileManager::Get().FileExists(*ResultsPath))
+		{
+			Output += TEXT("Actors,Iterations,CastNs,StaticNs,CachedOffsetNs,AttachedNs,BatchedNs") LINE_TERMINATOR;
+		}
+
+		Output += FString::Printf(TEXT("%d,%d,%.2f,%.2f,%.2f,%.2f,%.2f") LINE_TERMINATOR,
+			Result.NumActors, Result.NumIterations,
+			Result.CastNanoseconds, Result.StaticNanoseconds, Result.CachedOffsetNanoseconds, Result.AttachedNanoseconds, Result.BatchedNanoseconds);
+
+		FFileHelper::SaveStringToFile(Output, *ResultsPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	void RunLookupBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		using FBenchmarkService = UServiceLocatorBenchmarkObjectA;
+
+		if (World == nullptr)
+		{
+			UE_LOG(LogUnrealServiceLocator, Error, TEXT("ServiceLocator.Benchmark.Lookup: No world to spawn into"));
+			return;
+		}
+
+		FLookupBenchmarkResult Result;
+		Result.NumActors		= (Args.Num() > 0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+		Result.NumIterations	= (Args.Num() > 1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 100;
+
+		UServiceLocatorConfig* Config = CreateBenchmarkConfig(0, 1);
+		Config->AddToRoot();
+
+		FActorSpawnParameters ActorSpawnParameters;
+		ActorSpawnParameters.ObjectFlags = RF_Transient;
+		ActorSpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<AServiceLocatorBenchmarkActor*> Actors;
+		TArray<const AActor*> ActorsAsActors;
+		TArray<AServiceLocatorBenchmarkPlainActor*> PlainActors;
+
+		for (int32 Index = 0; Index < Result.NumActors; ++Index)
+		{
+			if (AServiceLocatorBenchmarkActor* Actor = World->SpawnActor<AServiceLocatorBenchmarkActor>(ActorSpawnParameters))
+			{
+				Actor->Container->SetConfig(Config);
+				Actor->Container->LocateAndCreateServices();
+				Actors.Add(Actor);
+				ActorsAsActors.Add(Actor);
+			}
+
+			if (AServiceLocatorBenchmarkPlainActor* PlainActor = World->SpawnActor<AServiceLocatorBenchmarkPlainActor>(ActorSpawnParameters))
+			{
+				PlainActor->Container->SetConfig(Config);
+				PlainActor->Container->LocateAndCreateServices();
+				FServiceLocatorContainerRegistry::AttachContainer(PlainActor, PlainActor->Container);
+				PlainActors.Add(PlainActor);
+			}
+		}
+
+		// Each lookup returns how many services it found, so that the compiler can't discard it, and a broken path shows up as a miss
+		auto Measure = [&Result](const TCHAR* Mode, int32 NumLookups, auto&& Lookup) -> double
+		{
+			int32 NumFound = 0;
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Result.NumIterations; ++Iteration)
+			{
+				NumFound += Lookup();
+			}
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+			const int32 NumExpected = NumLookups * Result.NumIterations;
+			if (NumFound != NumExpected)
+			{
+				UE_LOG(LogUnrealServiceLocator, Error, TEXT("ServiceLocator.Benchmark.Lookup: %s found %d of %d services"), Mode, NumFound, NumExpected);
+			}
+
+			return (Seconds * 1000000000.0) / FMath::Max(NumExpected, 1);
+		};
+
+		// The path every non-interface lookup used to take, for comparison
+		Result.CastNanoseconds = Measure(TEXT("Cast"), ActorsAsActors.Num(), [&ActorsAsActors]()
+		{
+			int32 NumFound = 0;
+			for (const AActor* Actor : ActorsAsActors)
+			{
+				const IServiceLocatorInterface* ActorAsSLI = Cast<const IServiceLocatorInterface>(Actor);
+				UServiceLocatorContainer* Container = (ActorAsSLI != nullptr) ? ActorAsSLI->GetContainer() : nullptr;
+				NumFound += ((Container != nullptr) && (Container->GetService<FBenchmarkService>() != nullptr)) ? 1 : 0;
+			}
+			return NumFound;
+		});
+
+		Result.StaticNanoseconds = Measure(TEXT("Static"), Actors.Num(), [&Actors]()
+		{
+			int32 NumFound = 0;
+			for (const AServiceLocatorBenchmarkActor* Actor : Actors)
+			{
+				NumFound += (UServiceLocatorContainer::GetService<FBenchmarkService>(Actor) != nullptr) ? 1 : 0;
+			}
+			return NumFound;
+		});
+
+		Result.CachedOffsetNanoseconds = Measure(TEXT("CachedOffset"), ActorsAsActors.Num(), [&ActorsAsActors]()
+		{
+			int32 NumFound = 0;
+			for (const AActor* Actor : ActorsAsActors)
+			{
+				NumFound += (UServiceLocatorContainer::GetService<FBenchmarkService>(Actor) != nullptr) ? 1 : 0;
+			}
+			return NumFound;
+		});
+
+		Result.AttachedNanoseconds = Measure(TEXT("Attached"), PlainActors.Num(), [&PlainActors]()
+		{
+			int32 NumFound = 0;
+			for (const AActor* PlainActor : PlainActors)
+			{
+				NumFound += (UServiceLocatorContainer::GetService<FBenchmarkService>(PlainActor) != nullptr) ? 1 : 0;
+			}
+			return NumFound;
+		});
+
+		TArray<FBenchmarkService*> BatchedServices;
+		Result.BatchedNanoseconds = Measure(TEXT("Batched"), ActorsAsActors.Num(), [&ActorsAsActors, &BatchedServices]()
+		{
+			UServiceLocatorContainer::GetServices<FBenchmarkService>(MakeArrayView(ActorsAsActors), BatchedServices);
+
+			int32 NumFound = 0;
+			for (const FBenchmarkService* Service : BatchedServices)
+			{
+				NumFound += (Service != nullptr) ? 1 : 0;
+			}
+			return NumFound;
+		});
+
+		for (AServiceLocatorBenchmarkActor* Actor : Actors)
+		{
+			Actor->Container->ShutdownServices();
+			Actor->Destroy();
+		}
+
+		for (AServiceLocatorBenchmarkPlainActor* PlainActor : PlainActors)
+		{
+			FServiceLocatorContainerRegistry::DetachContainer(PlainActor, PlainActor->Container);
+			PlainActor->Container->ShutdownServices();
+			PlainActor->Destroy();
+		}
+
+		Config->RemoveFromRoot();
+
+		UE_LOG(LogUnrealServiceLocator, Display, TEXT("ServiceLocator.Benchmark.Lookup: %d actors, %d iterations. Per lookup: Cast %.2fns, Static %.2fns, CachedOffset %.2fns, Attached %.2fns, Batched %.2fns"),
+			Result.NumActors, Result.NumIterations,
+			Result.CastNanoseconds, Result.StaticNanoseconds, Result.CachedOffsetNanoseconds, Result.AttachedNanoseconds, Result.BatchedNanoseconds);
+
+		WriteResult(Result);
+	}
+
+} // namespace ServiceLocatorBenchmark_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs ServiceLocatorBenchmarkLookupCommand(
+	TEXT("ServiceLocator.Benchmark.Lookup"),
+	TEXT("Spawns actors which each own a UServiceLocatorContainer, then times retrieving a service through each of them, recording the cost per lookup to Saved/Profiling/ServiceLocator/LookupBenchmark.csv.\n")
+	TEXT("Modes: Cast (interface cast per call), Static (object type derives from IServiceLocatorInterface), CachedOffset (per class interface offset), Attached (container attached to a plain actor), Batched (GetServices).\n")
+	TEXT("Usage: ServiceLocator.Benchmark.Lookup [NumActors=1000] [NumIterations=100]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ServiceLocatorBenchmark_Private::RunLookupBenchmark));
+
+///////////////////////////////////////////////////////////////////////////
+
+static FAutoConsoleCommandWithWorldAndArgs ServiceLocatorBenchmarkSpawnCommand(
+	TEXT("ServiceLocator.Benchmark.Spawn"),
+	TEXT("Spawns actors which each own a UServiceLocatorContainer, then destroys and garbage collects them, recording the cost to Saved/Profiling/ServiceLocator/SpawnBenchmark.csv.\n")
+	TEXT("Usage: ServiceLocator.Benchmark.Spawn [NumActors=1000] [NumComponentServices=2 (max 4)] [NumObjectServices=2 (max 4)]\n")
+	TEXT("Headless example: UE4Editor-Cmd <Project> <Map> -game -nullrhi -unattended -ExecCmds=\"ServiceLocator.Benchmark.Spawn 10000 4 4, quit\""),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ServiceLocatorBenchmark_Private::RunSpawnBenchmarkCommand));
+
+///////////////////////////////////////////////////////////////////////////
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Runs the spawn benchmark in a world of its own, failing if any ServiceLocator.Benchmark.Max* threshold is exceeded.
+ * Headless example: UE4Editor-Cmd <Project> -nullrhi -unattended -ini:Engine:[ConsoleVariables]:ServiceLocator.Benchmark.MaxSpawnMicrosecondsPerActor=50
+ *	-ExecCmds="Automation RunTests UnrealServiceLocator.Benchmark.Spawn; Quit"
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FServiceLocatorSpawnBenchmarkTest, "UnrealServiceLocator.Benchmark.Spawn",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FServiceLocatorSpawnBenchmarkTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ServiceLocatorBenchmarkWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	TArray<FString> Regressions;
+	const bool bPassed = ServiceLocatorBenchmark_Private::RunSpawnBenchmark(World, 1000, 4, 4, Regressions);
+
+	for (const FString& Regression : Regressions)
+	{
+		AddError(Regression);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return bPassed;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+///////////////////////////////////////////////////////////////////////////
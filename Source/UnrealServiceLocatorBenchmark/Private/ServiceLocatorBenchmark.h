@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorBenchmark.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+
+// UnrealServiceLocator
+#include "ServiceLocatorInterface.h"
+#include "ServiceLocatorBenchmark.generated.h"
+
+// Forward Declarations
+class UServiceLocatorContainer;
+
+///////////////////////////////////////////////////////////////////////////
+// Types spawned by the ServiceLocator.Benchmark.* console commands
+
+UCLASS(NotBlueprintable, NotPlaceable, Transient, HideDropdown)
+class AServiceLocatorBenchmarkActor : public AActor, public IServiceLocatorInterface
+{
+	GENERATED_BODY()
+
+public:
+
+	AServiceLocatorBenchmarkActor();
+
+	//////////////////////////////////////////////
+	// Overridden Functions - IServiceLocatorInterface
+
+	virtual UServiceLocatorContainer* GetContainer() const override { return Container; }
+
+	//////////////////////////////////////////////
+	// Data
+
+	UPROPERTY(Transient)
+	UServiceLocatorContainer* Container = nullptr;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+// Stands in for an engine or third-party actor, which can't implement IServiceLocatorInterface, so has its container attached instead
+UCLASS(NotBlueprintable, NotPlaceable, Transient, HideDropdown)
+class AServiceLocatorBenchmarkPlainActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	AServiceLocatorBenchmarkPlainActor();
+
+	//////////////////////////////////////////////
+	// Data
+
+	UPROPERTY(Transient)
+	UServiceLocatorContainer* Container = nullptr;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class UServiceLocatorBenchmarkComponentA : public UActorComponent { GENERATED_BODY() };
+
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class UServiceLocatorBenchmarkComponentB : public UActorComponent { GENERATED_BODY() };
+
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class UServiceLocatorBenchmarkComponentC : public UActorComponent { GENERATED_BODY() };
+
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class UServiceLocatorBenchmarkComponentD : public UActorComponent { GENERATED_BODY() };
+
+///////////////////////////////////////////////////////////////////////////
+
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class UServiceLocatorBenchmarkObjectA : public UObject { GENERATED_BODY() };
+
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class UServiceLocatorBenchmarkObjectB : public UObject { GENERATED_BODY() };
+
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class UServiceLocatorBenchmarkObjectC : public UObject { GENERATED_BODY() };
+
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class UServiceLocatorBenchmarkObjectD : public UObject { GENERATED_BODY() };
+
+///////////////////////////////////////////////////////////////////////////
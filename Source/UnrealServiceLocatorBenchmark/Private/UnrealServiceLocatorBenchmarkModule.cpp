@@ -0,0 +1,7 @@
+// UnrealServiceLocatorBenchmark.cpp
+
+// Engine
+#include "Modules/ModuleManager.h"
+
+// Only built for development targets, so that the benchmark types and commands never ship
+IMPLEMENT_MODULE(FDefaultModuleImpl, UnrealServiceLocatorBenchmark)
@@ -0,0 +1,23 @@
+using UnrealBuildTool;
+
+public class UnrealServiceLocatorBenchmark : ModuleRules
+{
+	public UnrealServiceLocatorBenchmark(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+        bLegacyPublicIncludePaths = false;
+
+        PrivateDependencyModuleNames.AddRange
+		(
+			new string[]
+			{
+                "UnrealServiceLocator",
+
+                "Core",
+				"CoreUObject",
+				"Engine",
+				"GameplayTags",
+			}
+		);
+	}
+}
@@ -90,17 +90,71 @@ void FServiceLocatorCustomization::CustomizeChildren(TSharedRef<IPropertyHandle>
 		RefreshTreeItems();
 	}
 
+	TSharedPtr<IPropertyHandle> ServiceKeyHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, ServiceKey));
+	if (ensure(ServiceKeyHandle.IsValid()))
+	{
+		ChildBuilder.AddProperty(ServiceKeyHandle.ToSharedRef());
+	}
+
+	TSharedPtr<IPropertyHandle> ServiceTagHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, ServiceTag));
+	if (ensure(ServiceTagHandle.IsValid()))
+	{
+		ChildBuilder.AddProperty(ServiceTagHandle.ToSharedRef());
+	}
+
 	TSharedPtr<IPropertyHandle> LocateBehaviourHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, LocateBehaviour));
 	if (ensure(LocateBehaviourHandle.IsValid()))
 	{
 		ChildBuilder.AddProperty(LocateBehaviourHandle.ToSharedRef());
 	}
 
+	TSharedPtr<IPropertyHandle> RecoveryBehaviourHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, RecoveryBehaviour));
+	if (ensure(RecoveryBehaviourHandle.IsValid()))
+	{
+		ChildBuilder.AddProperty(RecoveryBehaviourHandle.ToSharedRef());
+	}
+
 	TSharedPtr<IPropertyHandle> DebugOnlyHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, bDebugOnly));
 	if (ensure(DebugOnlyHandle.IsValid()))
 	{
 		ChildBuilder.AddProperty(DebugOnlyHandle.ToSharedRef());
 	}
+
+	TSharedPtr<IPropertyHandle> ConditionsHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, Conditions));
+	if (ensure(ConditionsHandle.IsValid()))
+	{
+		ChildBuilder.AddProperty(ConditionsHandle.ToSharedRef());
+	}
+
+	TSharedPtr<IPropertyHandle> CriticalHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, bCritical));
+	if (ensure(CriticalHandle.IsValid()))
+	{
+		ChildBuilder.AddProperty(CriticalHandle.ToSharedRef());
+	}
+
+	TSharedPtr<IPropertyHandle> ThreadAffinityHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, ThreadAffinity));
+	if (ensure(ThreadAffinityHandle.IsValid()))
+	{
+		ChildBuilder.AddProperty(ThreadAffinityHandle.ToSharedRef());
+	}
+
+	TSharedPtr<IPropertyHandle> TickSettingsHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, TickSettings));
+	if (ensure(TickSettingsHandle.IsValid()))
+	{
+		ChildBuilder.AddProperty(TickSettingsHandle.ToSharedRef());
+	}
+
+	TSharedPtr<IPropertyHandle> SpawnSettingsHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, SpawnSettings));
+	if (ensure(SpawnSettingsHandle.IsValid()))
+	{
+		ChildBuilder.AddProperty(SpawnSettingsHandle.ToSharedRef());
+	}
+
+	TSharedPtr<IPropertyHandle> FactoryHandle = StructPropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FServiceDescriptor, Factory));
+	if (ensure(FactoryHandle.IsValid()))
+	{
+		ChildBuilder.AddProperty(FactoryHandle.ToSharedRef());
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -117,14 +171,14 @@ void FServiceLocatorCustomization::OnClassCheckStatusChanged(ECheckBoxState NewC
 	{
 		for (FServiceDescriptor* ServiceDescriptor : EditableDescriptors)
 		{
-			ServiceDescriptor->MappedTypes.AddUnique(NodeClass);
+			ServiceDescriptor->MappedTypes.AddUnique(TSoftClassPtr<UObject>(NodeClass));
 		}
 	}
 	else
 	{
 		for (FServiceDescriptor* ServiceDescriptor : EditableDescriptors)
 		{
-			ServiceDescriptor->MappedTypes.Remove(NodeClass);
+			ServiceDescriptor->MappedTypes.Remove(TSoftClassPtr<UObject>(NodeClass));
 		}
 	}
 
@@ -140,7 +194,7 @@ ECheckBoxState FServiceLocatorCustomization::IsClassChecked(FServiceLocatorTreeI
 	TOptional<bool> bIsChecked;
 	for (FServiceDescriptor* ServiceDescriptor : EditableDescriptors)
 	{
-		const bool bContainsClass = ServiceDescriptor->MappedTypes.Contains(NodeClass);
+		const bool bContainsClass = ServiceDescriptor->MappedTypes.Contains(TSoftClassPtr<UObject>(NodeClass));
 		
 		if (!bIsChecked.IsSet())
 		{
@@ -211,8 +265,8 @@ void FServiceLocatorCustomization::RefreshTreeItems()
 		if (ServiceDescriptor == nullptr)
 			continue;
 
-		// The service type for this descriptor could be null
-		UClass* ServiceType = ServiceDescriptor->ServiceType;
+		// The service type for this descriptor could be null. Types are soft references, so they're loaded to be displayed.
+		UClass* ServiceType = ServiceDescriptor->ServiceType.LoadSynchronous();
 		if (ServiceType != nullptr)
 		{
 			for (const FImplementedInterface& ImplementedInterface : ServiceType->Interfaces)
@@ -227,8 +281,9 @@ void FServiceLocatorCustomization::RefreshTreeItems()
 			}
 		}
 
-		for (UClass* MappedType : ServiceDescriptor->MappedTypes)
+		for (const TSoftClassPtr<UObject>& MappedTypePtr : ServiceDescriptor->MappedTypes)
 		{
+			UClass* MappedType = MappedTypePtr.LoadSynchronous();
 			if (MappedType == nullptr)
 				continue;
 
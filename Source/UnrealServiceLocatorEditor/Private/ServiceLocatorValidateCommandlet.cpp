@@ -0,0 +1,236 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorValidateCommandlet.cpp
+///////////////////////////////////////////////////////////////////////////
+
+// UnrealServiceLocatorEditor
+#include "ServiceLocatorValidateCommandlet.h"
+
+// UnrealServiceLocator
+#include "ServiceLocatorConfig.h"
+
+// Engine
+#include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+DEFINE_LOG_CATEGORY_STATIC(LogServiceLocatorValidate, Log, All);
+
+///////////////////////////////////////////////////////////////////////////
+
+namespace ServiceLocatorValidateCommandlet_Private
+{
+
+	using FReportWriter = TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>;
+
+	void LoadServiceClasses(UServiceLocatorConfig* Config)
+	{
+		for (FServiceDescriptor& ServiceDescriptor : Config->ServiceDescriptors)
+		{
+			ServiceDescriptor.ServiceType.LoadSynchronous();
+
+			for (TSoftClassPtr<UObject>& MappedType : ServiceDescriptor.MappedTypes)
+			{
+				MappedType.LoadSynchronous();
+			}
+		}
+	}
+
+	FString GetServiceTypeName(const UServiceLocatorConfig* Config, int32 DescriptorIndex)
+	{
+		return Config->ServiceDescriptors.IsValidIndex(DescriptorIndex) ? Config->ServiceDescriptors[DescriptorIndex].ServiceType.ToString() : FString();
+	}
+
+	void WriteConfig(FReportWriter& Writer, const UServiceLocatorConfig* Config, const FServiceConfigValidation& Validation)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("config"), Config->GetPathName());
+		Writer.WriteValue(TEXT("numErrors"), Validation.GetNumErrors());
+
+		Writer.WriteArrayStart(TEXT("issues"));
+		for (const FServiceConfigValidationIssue& Issue : Validation.Issues)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("descriptor"), Issue.DescriptorIndex);
+			Writer.WriteValue(TEXT("severity"), Issue.bError ? TEXT("error") : TEXT("warning"));
+			Writer.WriteValue(TEXT("message"), Issue.Message);
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+
+		Writer.WriteArrayStart(TEXT("displacements"));
+		for (const FServiceConfigDisplacement& Displacement : Validation.Displacements)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("mappedType"), GetPathNameSafe(Displacement.MappedType));
+			Writer.WriteValue(TEXT("key"), Displacement.ServiceKey.ToString());
+			Writer.WriteValue(TEXT("displacedDescriptor"), Displacement.DisplacedDescriptorIndex);
+			Writer.WriteValue(TEXT("descriptor"), Displacement.DescriptorIndex);
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+
+		Writer.WriteArrayStart(TEXT("services"));
+		for (int32 DescriptorIndex = 0; DescriptorIndex < Config->ServiceDescriptors.Num(); ++DescriptorIndex)
+		{
+			const FServiceDescriptor& ServiceDescriptor = Config->ServiceDescriptors[DescriptorIndex];
+
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("descriptor"), DescriptorIndex);
+			Writer.WriteValue(TEXT("serviceType"), ServiceDescriptor.ServiceType.ToString());
+			Writer.WriteValue(TEXT("key"), ServiceDescriptor.GetServiceKey().ToString());
+			Writer.WriteArrayStart(TEXT("mappedTypes"));
+			for (const TSoftClassPtr<UObject>& MappedType : ServiceDescriptor.MappedTypes)
+			{
+				Writer.WriteValue(MappedType.ToString());
+			}
+			Writer.WriteArrayEnd();
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+
+		Writer.WriteArrayStart(TEXT("dependencies"));
+		for (const FServiceConfigDependency& Dependency : Validation.Dependencies)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("descriptor"), Dependency.DescriptorIndex);
+			Writer.WriteValue(TEXT("serviceType"), GetPathNameSafe(Dependency.ServiceType));
+			Writer.WriteValue(TEXT("key"), Dependency.ServiceKey.ToString());
+			Writer.WriteValue(TEXT("dependencyDescriptor"), Dependency.DependencyDescriptorIndex);
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+
+		Writer.WriteObjectEnd();
+	}
+
+} // namespace ServiceLocatorValidateCommandlet_Private
+
+///////////////////////////////////////////////////////////////////////////
+
+UServiceLocatorValidateCommandlet::UServiceLocatorValidateCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+int32 UServiceLocatorValidateCommandlet::Main(const FString& Params)
+{
+	using namespace ServiceLocatorValidateCommandlet_Private;
+
+	FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ServiceLocator"), TEXT("ValidationReport.json"));
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	FString PackagePath = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), PackagePath);
+
+	const bool bWarningsAsErrors = FParse::Param(*Params, TEXT("WarningsAsErrors"));
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassNames.Add(UServiceLocatorConfig::StaticClass()->GetFName());
+	Filter.PackagePaths.Add(FName(*PackagePath));
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+
+	TArray<FAssetData> ConfigAssets;
+	AssetRegistry.GetAssets(Filter, ConfigAssets);
+
+	// Loading and resolving classes has to happen on the game thread, so everything is resolved up front, leaving validation free to run in parallel
+	TArray<UServiceLocatorConfig*> Configs;
+	TArray<FServiceDescriptorClasses> ConfigClasses;
+	Configs.Reserve(ConfigAssets.Num());
+	ConfigClasses.Reserve(ConfigAssets.Num());
+
+	for (const FAssetData& ConfigAsset : ConfigAssets)
+	{
+		UServiceLocatorConfig* Config = Cast<UServiceLocatorConfig>(ConfigAsset.GetAsset());
+		if (Config == nullptr)
+		{
+			UE_LOG(LogServiceLocatorValidate, Error, TEXT("UServiceLocatorValidateCommandlet::Main: Unable to load config '%s'"), *ConfigAsset.ObjectPath.ToString());
+			continue;
+		}
+
+		LoadServiceClasses(Config);
+		Configs.Emplace(Config);
+		Config->ResolveClasses(ConfigClasses.AddDefaulted_GetRef());
+	}
+
+	TArray<FServiceConfigValidation> Validations;
+	Validations.SetNum(Configs.Num());
+
+	ParallelFor(Configs.Num(), [&Configs, &ConfigClasses, &Validations](int32 ConfigIndex)
+	{
+		Configs[ConfigIndex]->Validate(ConfigClasses[ConfigIndex], Validations[ConfigIndex]);
+	});
+
+	int32 NumErrors = ConfigAssets.Num() - Configs.Num();
+	int32 NumWarnings = 0;
+
+	FString Report;
+	TSharedRef<FReportWriter> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Report);
+	Writer->WriteObjectStart();
+	Writer->WriteArrayStart(TEXT("configs"));
+
+	for (int32 ConfigIndex = 0; ConfigIndex < Configs.Num(); ++ConfigIndex)
+	{
+		const UServiceLocatorConfig* Config = Configs[ConfigIndex];
+		const FServiceConfigValidation& Validation = Validations[ConfigIndex];
+
+		WriteConfig(*Writer, Config, Validation);
+
+		for (const FServiceConfigValidationIssue& Issue : Validation.Issues)
+		{
+			if (Issue.bError)
+			{
+				UE_LOG(LogServiceLocatorValidate, Error, TEXT("%s [%d] '%s': %s"),
+					*Config->GetPathName(), Issue.DescriptorIndex, *GetServiceTypeName(Config, Issue.DescriptorIndex), *Issue.Message);
+			}
+			else
+			{
+				UE_LOG(LogServiceLocatorValidate, Warning, TEXT("%s [%d] '%s': %s"),
+					*Config->GetPathName(), Issue.DescriptorIndex, *GetServiceTypeName(Config, Issue.DescriptorIndex), *Issue.Message);
+			}
+		}
+
+		for (const FServiceConfigDisplacement& Displacement : Validation.Displacements)
+		{
+			UE_LOG(LogServiceLocatorValidate, Warning, TEXT("%s [%d]: Type '%s' with key '%s' is displaced by descriptor [%d]"),
+				*Config->GetPathName(), Displacement.DisplacedDescriptorIndex, *GetNameSafe(Displacement.MappedType), *Displacement.ServiceKey.ToString(), Displacement.DescriptorIndex);
+		}
+
+		const int32 NumConfigErrors = Validation.GetNumErrors();
+		NumErrors += NumConfigErrors;
+		NumWarnings += (Validation.Issues.Num() - NumConfigErrors) + Validation.Displacements.Num();
+	}
+
+	Writer->WriteArrayEnd();
+	Writer->WriteValue(TEXT("numConfigs"), ConfigAssets.Num());
+	Writer->WriteValue(TEXT("numErrors"), NumErrors);
+	Writer->WriteValue(TEXT("numWarnings"), NumWarnings);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (!FFileHelper::SaveStringToFile(Report, *ReportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogServiceLocatorValidate, Error, TEXT("UServiceLocatorValidateCommandlet::Main: Unable to write report to '%s'"), *ReportPath);
+		return 1;
+	}
+
+	UE_LOG(LogServiceLocatorValidate, Display, TEXT("UServiceLocatorValidateCommandlet::Main: Validated %d configs with %d errors and %d warnings, report written to '%s'"),
+		Configs.Num(), NumErrors, NumWarnings, *ReportPath);
+
+	return ((NumErrors > 0) || (bWarningsAsErrors && (NumWarnings > 0))) ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
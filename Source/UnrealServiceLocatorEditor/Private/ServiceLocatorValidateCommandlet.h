@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////
+// ServiceLocatorValidateCommandlet.h
+///////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Engine
+#include "Commandlets/Commandlet.h"
+
+// UnrealServiceLocatorEditor
+#include "ServiceLocatorValidateCommandlet.generated.h"
+
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Loads every UServiceLocatorConfig in the project and validates them in parallel, then writes a JSON report of the issues,
+ * mapping displacements and service graph of each config. Returns non-zero if any config has errors, so that it can gate a cook.
+ *
+ * Usage: UE4Editor-Cmd <Project> -run=ServiceLocatorValidate [-Report=<File>] [-Path=<PackagePath>] [-WarningsAsErrors]
+ */
+UCLASS()
+class UServiceLocatorValidateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UServiceLocatorValidateCommandlet();
+
+	//////////////////////////////////////////////
+	// Overridden Functions - UCommandlet
+
+	virtual int32 Main(const FString& Params) override;
+
+};
+
+///////////////////////////////////////////////////////////////////////////
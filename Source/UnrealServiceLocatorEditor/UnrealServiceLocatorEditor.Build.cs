@@ -21,6 +21,8 @@ public class UnrealServiceLocatorEditor : ModuleRules
                 "ApplicationCore",
 				"InputCore",
 				"PropertyEditor",
+				"AssetRegistry",
+				"Json",
 			}
 		);
 	}